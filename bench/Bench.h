@@ -0,0 +1,83 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace bench {
+
+/**
+ * @brief Per-run state handed to a benchmark body
+ * The body loops while keepRunning() is true and may report the number of
+ * bytes it touched so the runner can print throughput.
+ */
+class State {
+private:
+    uint64_t remaining;
+    uint64_t iterations;
+    uint64_t bytesProcessed;
+    std::string skipReason;
+
+public:
+    explicit State(uint64_t iterations)
+        : remaining(iterations), iterations(iterations), bytesProcessed(0) {}
+
+    /**
+     * @brief Returns true while there are iterations left to run
+     */
+    bool keepRunning() {
+        if (remaining == 0) return false;
+        --remaining;
+        return true;
+    }
+
+    uint64_t getIterations() const { return iterations; }
+
+    /**
+     * @brief Sets the total bytes processed over all iterations
+     */
+    void setBytesProcessed(uint64_t bytes) { bytesProcessed = bytes; }
+    uint64_t getBytesProcessed() const { return bytesProcessed; }
+
+    /**
+     * @brief Marks the benchmark as not runnable here (e.g. missing CPU feature)
+     */
+    void skip(const std::string& reason) { skipReason = reason; }
+    bool isSkipped() const { return !skipReason.empty(); }
+    const std::string& getSkipReason() const { return skipReason; }
+};
+
+using BenchFunc = std::function<void(State&)>;
+
+/**
+ * @brief Registers a benchmark with the runner
+ * @return Always true, so it can initialize a static flag
+ */
+bool registerBenchmark(const std::string& name, BenchFunc func);
+
+/**
+ * @brief Keeps the optimizer from discarding a computed value
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+} // namespace bench
+
+/**
+ * @brief Defines and registers a benchmark body: BENCHMARK(name) { while (state.keepRunning()) ... }
+ */
+#define BENCHMARK(name)                                                          \
+    static void name(::bench::State& state);                                     \
+    [[maybe_unused]] static const bool name##Registered =                        \
+        ::bench::registerBenchmark(#name, name);                                 \
+    static void name(::bench::State& state)
+
+#endif // BENCH_H
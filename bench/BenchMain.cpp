@@ -0,0 +1,239 @@
+#include "Bench.h"
+#include "PixelKernels.h"
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+namespace {
+
+struct Entry {
+    std::string name;
+    BenchFunc func;
+};
+
+std::vector<Entry>& getRegistry() {
+    static std::vector<Entry> registry;
+    return registry;
+}
+
+// Minimum wall time a measurement must cover before it is reported
+constexpr double kMinSeconds = 0.2;
+
+struct Result {
+    std::string name;
+    uint64_t iterations = 0;
+    double realSeconds = 0.0;
+    double cpuSeconds = 0.0;
+    uint64_t bytes = 0;
+    std::string skipReason;
+
+    double realNsPerOp() const { return realSeconds * 1e9 / static_cast<double>(iterations); }
+    double cpuNsPerOp() const { return cpuSeconds * 1e9 / static_cast<double>(iterations); }
+    double bytesPerSecond() const { return realSeconds > 0 ? bytes / realSeconds : 0.0; }
+};
+
+/**
+ * @brief Runs one benchmark, growing the iteration count until the run is long enough to trust
+ */
+Result runBenchmark(const Entry& entry) {
+    Result result;
+    result.name = entry.name;
+    uint64_t iterations = 1;
+    while (true) {
+        State state(iterations);
+        std::clock_t cpuStart = std::clock();
+        auto start = std::chrono::steady_clock::now();
+        entry.func(state);
+        auto end = std::chrono::steady_clock::now();
+        std::clock_t cpuEnd = std::clock();
+
+        result.iterations = iterations;
+        result.realSeconds = std::chrono::duration<double>(end - start).count();
+        result.cpuSeconds = static_cast<double>(cpuEnd - cpuStart) / CLOCKS_PER_SEC;
+        result.bytes = state.getBytesProcessed();
+        if (state.isSkipped()) {
+            result.skipReason = state.getSkipReason();
+            break;
+        }
+        if (result.realSeconds >= kMinSeconds || iterations >= (1ull << 40)) {
+            break;
+        }
+        iterations *= (result.realSeconds < kMinSeconds / 10) ? 10 : 2;
+    }
+    return result;
+}
+
+// ============== Console Output ==============
+
+void printConsoleHeader() {
+    std::cout << std::left << std::setw(32) << "Benchmark"
+              << std::right << std::setw(12) << "Iterations"
+              << std::setw(16) << "ns/op"
+              << std::setw(12) << "GB/s" << std::endl;
+    std::cout << std::string(72, '-') << std::endl;
+}
+
+void printConsoleRow(const Result& result) {
+    if (!result.skipReason.empty()) {
+        std::cout << std::left << std::setw(32) << result.name
+                  << "  skipped: " << result.skipReason << std::endl;
+        return;
+    }
+
+    std::cout << std::left << std::setw(32) << result.name
+              << std::right << std::setw(12) << result.iterations
+              << std::setw(16) << std::fixed << std::setprecision(1) << result.realNsPerOp();
+    if (result.bytes > 0) {
+        std::cout << std::setw(12) << std::setprecision(2) << (result.bytesPerSecond() / 1e9);
+    } else {
+        std::cout << std::setw(12) << "-";
+    }
+    std::cout << std::endl;
+}
+
+// ============== Machine-Readable Output ==============
+
+std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+std::string currentDate() {
+    std::time_t now = std::time(nullptr);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+    return buffer;
+}
+
+/**
+ * @brief Writes results in the Google Benchmark JSON layout, so its compare tooling can diff two runs
+ */
+void writeJson(std::ostream& out, const std::vector<Result>& results) {
+    out << "{\n  \"context\": {\n"
+        << "    \"date\": \"" << currentDate() << "\",\n"
+#ifdef NDEBUG
+        << "    \"library_build_type\": \"release\",\n"
+#else
+        << "    \"library_build_type\": \"debug\",\n"
+#endif
+        << "    \"pixel_kernel_level\": \"" << PixelKernels::getLevelName(PixelKernels::getLevel()) << "\"\n"
+        << "  },\n  \"benchmarks\": [";
+
+    bool first = true;
+    for (const Result& result : results) {
+        if (!result.skipReason.empty()) continue;
+        out << (first ? "\n" : ",\n") << std::fixed << std::setprecision(3)
+            << "    {\"name\": \"" << jsonEscape(result.name) << "\", \"run_type\": \"iteration\", "
+            << "\"iterations\": " << result.iterations << ", "
+            << "\"real_time\": " << result.realNsPerOp() << ", "
+            << "\"cpu_time\": " << result.cpuNsPerOp() << ", \"time_unit\": \"ns\"";
+        if (result.bytes > 0) {
+            out << ", \"bytes_per_second\": " << std::setprecision(0) << result.bytesPerSecond();
+        }
+        out << "}";
+        first = false;
+    }
+    out << "\n  ]\n}\n";
+}
+
+void writeCsv(std::ostream& out, const std::vector<Result>& results) {
+    out << "name,iterations,real_time,cpu_time,time_unit,bytes_per_second,skipped\n";
+    for (const Result& result : results) {
+        out << result.name << ',';
+        if (!result.skipReason.empty()) {
+            out << ",,,,,\"" << result.skipReason << "\"\n";
+            continue;
+        }
+        out << result.iterations << ',' << std::fixed << std::setprecision(3)
+            << result.realNsPerOp() << ',' << result.cpuNsPerOp() << ",ns,";
+        if (result.bytes > 0) out << std::setprecision(0) << result.bytesPerSecond();
+        out << ",\n";
+    }
+}
+
+bool endsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() &&
+           text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+} // namespace
+
+bool registerBenchmark(const std::string& name, BenchFunc func) {
+    getRegistry().push_back({name, std::move(func)});
+    return true;
+}
+
+} // namespace bench
+
+/**
+ * @brief Runs every registered benchmark whose name contains the filter (if given)
+ * Usage: slideshow_bench [filter] [--format=console|json|csv] [--out=results.json|results.csv]
+ */
+int main(int argc, char* argv[]) {
+    std::string filter;
+    std::string format = "console";
+    std::string outPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 9, "--format=") == 0) {
+            format = arg.substr(9);
+        } else if (arg.compare(0, 6, "--out=") == 0) {
+            outPath = arg.substr(6);
+        } else {
+            filter = arg;
+        }
+    }
+    if (format != "console" && format != "json" && format != "csv") {
+        std::cerr << "Unknown format: " << format << " (expected console, json or csv)" << std::endl;
+        return 2;
+    }
+
+    // Progress goes to the console only when stdout is not carrying data
+    bool console = format == "console";
+    if (console) {
+        bench::printConsoleHeader();
+    }
+
+    std::vector<bench::Result> results;
+    for (const auto& entry : bench::getRegistry()) {
+        if (!filter.empty() && entry.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        results.push_back(bench::runBenchmark(entry));
+        if (console) {
+            bench::printConsoleRow(results.back());
+        }
+    }
+
+    if (format == "json") {
+        bench::writeJson(std::cout, results);
+    } else if (format == "csv") {
+        bench::writeCsv(std::cout, results);
+    }
+
+    if (!outPath.empty()) {
+        std::ofstream out(outPath);
+        if (!out.is_open()) {
+            std::cerr << "Failed to open: " << outPath << std::endl;
+            return 1;
+        }
+        if (bench::endsWith(outPath, ".csv")) {
+            bench::writeCsv(out, results);
+        } else {
+            bench::writeJson(out, results);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include "Bench.h"
+#include "Canvas.h"
+#include "Color.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ============== Circle / Ellipse Primitives ==============
+
+BENCHMARK(CanvasFillCircle) {
+    Canvas canvas(640, 480);
+    while (state.keepRunning()) {
+        canvas.fillCircle(320, 240, 200, Color::Red());
+    }
+    bench::doNotOptimize(canvas);
+}
+
+BENCHMARK(CanvasDrawCircle) {
+    Canvas canvas(640, 480);
+    while (state.keepRunning()) {
+        canvas.drawCircle(320, 240, 200, Color::White(), 4);
+    }
+    bench::doNotOptimize(canvas);
+}
+
+BENCHMARK(CanvasFillEllipse) {
+    Canvas canvas(640, 480);
+    while (state.keepRunning()) {
+        canvas.fillEllipse(320, 240, 300, 180, Color::Pink());
+    }
+    bench::doNotOptimize(canvas);
+}
+
+BENCHMARK(CanvasDrawEllipse) {
+    Canvas canvas(640, 480);
+    while (state.keepRunning()) {
+        canvas.drawEllipse(320, 240, 300, 180, Color::White(), 4);
+    }
+    bench::doNotOptimize(canvas);
+}
+
+// ============== Line / Polygon Strokes ==============
+
+BENCHMARK(CanvasDrawLineThick) {
+    Canvas canvas(640, 480);
+    while (state.keepRunning()) {
+        canvas.drawLine(10, 20, 630, 400, Color::White(), 8);
+    }
+    bench::doNotOptimize(canvas);
+}
+
+BENCHMARK(CanvasDrawPolygonThick) {
+    Canvas canvas(640, 480);
+    std::vector<std::pair<int, int>> points = {
+        {320, 40}, {500, 180}, {440, 420}, {200, 420}, {140, 180}
+    };
+    while (state.keepRunning()) {
+        canvas.drawPolygon(points, Color::Orange(), 6);
+    }
+    bench::doNotOptimize(canvas);
+}
+
+// ============== Anti-Aliased Variants ==============
+
+BENCHMARK(CanvasFillCircleAA) {
+    Canvas canvas(640, 480);
+    canvas.setAntiAliasing(true);
+    while (state.keepRunning()) {
+        canvas.fillCircle(320, 240, 200, Color::Red());
+    }
+    bench::doNotOptimize(canvas);
+}
+
+BENCHMARK(CanvasDrawPolygonThickAA) {
+    Canvas canvas(640, 480);
+    canvas.setAntiAliasing(true);
+    std::vector<std::pair<int, int>> points = {
+        {320, 40}, {500, 180}, {440, 420}, {200, 420}, {140, 180}
+    };
+    while (state.keepRunning()) {
+        canvas.drawPolygon(points, Color::Orange(), 6);
+    }
+    bench::doNotOptimize(canvas);
+}
+
+// ============== ASCII Preview ==============
+
+BENCHMARK(CanvasToAsciiArt) {
+    // Default slide size gives a 160x45 preview; give every cell its own color
+    Canvas canvas(320, 180);
+    for (int y = 0; y < 180; y += 4) {
+        for (int x = 0; x < 320; x += 2) {
+            canvas.fillRect(x, y, 2, 4, Color(static_cast<uint8_t>(x * 4 / 5), static_cast<uint8_t>(y * 7 / 5),
+                                              static_cast<uint8_t>((x + y) / 2)));
+        }
+    }
+    uint64_t bytes = 0;
+    while (state.keepRunning()) {
+        std::string art = canvas.toAsciiArt();
+        bytes += art.size();
+        bench::doNotOptimize(art);
+    }
+    state.setBytesProcessed(bytes);
+}
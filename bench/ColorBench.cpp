@@ -0,0 +1,51 @@
+#include "Bench.h"
+#include "Color.h"
+#include <string>
+
+// ============== Name Lookup ==============
+
+BENCHMARK(ColorGetNameNamed) {
+    Color colors[] = {Color::Red(), Color::Gray(), Color::Violet(), Color::Black()};
+    size_t length = 0;
+    while (state.keepRunning()) {
+        for (const Color& c : colors) {
+            length += c.getName().size();
+        }
+    }
+    bench::doNotOptimize(length);
+}
+
+BENCHMARK(ColorGetNameRGB) {
+    Color colors[] = {Color(1, 2, 3), Color(200, 100, 50), Color(17, 170, 255), Color(99, 0, 9)};
+    size_t length = 0;
+    while (state.keepRunning()) {
+        for (const Color& c : colors) {
+            length += c.getName().size();
+        }
+    }
+    bench::doNotOptimize(length);
+}
+
+BENCHMARK(ColorFromName) {
+    const std::string names[] = {"red", "Violet", "GREY", "unknown"};
+    unsigned sum = 0;
+    while (state.keepRunning()) {
+        for (const std::string& name : names) {
+            sum += Color(name).r;
+        }
+    }
+    bench::doNotOptimize(sum);
+}
+
+// ============== ANSI Formatting ==============
+
+BENCHMARK(ColorToAnsiFg) {
+    Color colors[] = {Color::Red(), Color::Cyan(), Color::Gray(), Color(100, 100, 120)};
+    size_t length = 0;
+    while (state.keepRunning()) {
+        for (const Color& c : colors) {
+            length += c.toAnsiFg().size();
+        }
+    }
+    bench::doNotOptimize(length);
+}
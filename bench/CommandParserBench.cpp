@@ -0,0 +1,54 @@
+#include "Bench.h"
+#include "CommandParser.h"
+#include <cstdint>
+#include <string>
+
+namespace {
+
+// A mix of lines like those in batch scripts: aliases, arguments and typos
+const std::string kScriptLines[] = {
+    "next",
+    "  prev",
+    "goto 3",
+    "goto .\\Decks\\Intro.txt 2",
+    "delete 4",
+    "exportjson slide.json all",
+    "HISTORY",
+    "saveas",
+    "bogus command",
+    "q"
+};
+
+uint64_t scriptBytes() {
+    uint64_t bytes = 0;
+    for (const std::string& line : kScriptLines) {
+        bytes += line.size();
+    }
+    return bytes;
+}
+
+} // namespace
+
+// ============== Command Parsing ==============
+
+BENCHMARK(CommandParse) {
+    int sum = 0;
+    while (state.keepRunning()) {
+        for (const std::string& line : kScriptLines) {
+            CommandParser::Command cmd = CommandParser::parse(line);
+            sum += cmd.type + static_cast<int>(cmd.args.size());
+        }
+    }
+    state.setBytesProcessed(state.getIterations() * scriptBytes());
+    bench::doNotOptimize(sum);
+}
+
+BENCHMARK(CommandTokenize) {
+    const std::string line = "export   slide_one.bmp  noaa";
+    size_t count = 0;
+    while (state.keepRunning()) {
+        count += CommandParser::tokenize(line).size();
+    }
+    state.setBytesProcessed(state.getIterations() * line.size());
+    bench::doNotOptimize(count);
+}
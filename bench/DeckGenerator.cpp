@@ -0,0 +1,116 @@
+#include "DeckGenerator.h"
+#include "Color.h"
+#include "ShapeFactory.h"
+#include "Tokenizer.h"
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+namespace {
+
+/**
+ * @brief Small deterministic generator (PCG-style LCG)
+ * Unlike the <random> distributions its output is identical on every standard library.
+ */
+class DeckRandom {
+private:
+    uint64_t state;
+
+public:
+    explicit DeckRandom(uint64_t seed) : state(seed * 6364136223846793005ull + 1442695040888963407ull) {}
+
+    uint32_t next() {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<uint32_t>(state >> 33);
+    }
+
+    // Uniform in [low, high]
+    int range(int low, int high) {
+        return low + static_cast<int>(next() % static_cast<uint32_t>(high - low + 1));
+    }
+};
+
+/**
+ * @brief Parses "Circle:3, Star" into (type, weight) pairs; weight defaults to 1
+ */
+std::vector<std::pair<std::string, int>> parseShapeMix(const std::string& mix) {
+    std::vector<std::pair<std::string, int>> weighted;
+    for (const std::string& entry : Tokenizer::split(mix, ',')) {
+        if (entry.empty()) continue;
+        size_t colon = entry.find(':');
+        std::string type = Tokenizer::trim(entry.substr(0, colon));
+        int weight = 1;
+        if (colon != std::string::npos) {
+            try {
+                weight = std::stoi(entry.substr(colon + 1));
+            } catch (...) {}
+        }
+        if (weight > 0 && ShapeFactory::isValidShape(type)) {
+            weighted.emplace_back(type, weight);
+        }
+    }
+    return weighted;
+}
+
+const std::string& pickType(const std::vector<std::pair<std::string, int>>& mix, int totalWeight, DeckRandom& random) {
+    int pick = random.range(0, totalWeight - 1);
+    for (const auto& entry : mix) {
+        if (pick < entry.second) return entry.first;
+        pick -= entry.second;
+    }
+    return mix.back().first;
+}
+
+} // namespace
+
+Slide generateSlide(const DeckSpec& spec, int slideIndex) {
+    Slide slide(spec.canvasWidth, spec.canvasHeight);
+
+    std::vector<std::pair<std::string, int>> mix = parseShapeMix(spec.shapeMix);
+    if (mix.empty()) return slide;
+    int totalWeight = 0;
+    for (const auto& entry : mix) totalWeight += entry.second;
+
+    std::vector<std::string> colors = Color::getAvailableColors();
+    DeckRandom random(static_cast<uint64_t>(spec.seed) * 1000003u + static_cast<uint64_t>(slideIndex));
+
+    // Shapes span up to a third of the canvas and may overlap its edges
+    int maxWidth = std::max(4, spec.canvasWidth / 3);
+    int maxHeight = std::max(4, spec.canvasHeight / 3);
+    for (int i = 0; i < spec.shapesPerSlide; ++i) {
+        const std::string& type = pickType(mix, totalWeight, random);
+
+        ShapeFactory::ShapeParams params;
+        params.x = random.range(-maxWidth / 4, spec.canvasWidth - 1);
+        params.y = random.range(-maxHeight / 4, spec.canvasHeight - 1);
+        params.width = random.range(4, maxWidth);
+        params.height = random.range(4, maxHeight);
+        params.fillColor = Color(colors[random.next() % colors.size()]);
+        params.borderColor = Color(colors[random.next() % colors.size()]);
+        params.borderWidth = random.range(1, 4);
+        params.filled = random.range(0, 3) != 0;
+        params.x2 = params.x + params.width;
+        params.y2 = params.y + params.height;
+        params.text = "Slide " + std::to_string(slideIndex + 1);
+
+        auto shape = ShapeFactory::create(type, params);
+        if (shape) {
+            slide.addShape(std::shared_ptr<Shape>(shape.release()));
+        }
+    }
+    return slide;
+}
+
+std::string generateDeckText(const DeckSpec& spec) {
+    std::string text;
+    for (int i = 0; i < spec.slides; ++i) {
+        if (i > 0) text += "---\n";
+        text += generateSlide(spec, i).toFileFormat();
+    }
+    return text;
+}
+
+} // namespace bench
@@ -0,0 +1,39 @@
+#ifndef DECKGENERATOR_H
+#define DECKGENERATOR_H
+
+#include "Slide.h"
+#include <cstdint>
+#include <string>
+
+namespace bench {
+
+/**
+ * @brief Describes a synthetic deck for benchmarks
+ * The same spec always generates the same shapes, so results stay
+ * comparable across builds and releases.
+ */
+struct DeckSpec {
+    int slides = 1;
+    int shapesPerSlide = 50;
+    int canvasWidth = 320;
+    int canvasHeight = 180;
+
+    // Comma-separated shape types with optional weights, e.g. "Circle:3, Star"
+    std::string shapeMix = "Circle, Rectangle, Square, Triangle, Diamond, Star, "
+                           "Hexagon, Pentagon, Oval, Trapezoid, Rhombus, Line";
+    uint32_t seed = 1;
+};
+
+/**
+ * @brief Generates one slide of the deck (0-based index)
+ */
+Slide generateSlide(const DeckSpec& spec, int slideIndex = 0);
+
+/**
+ * @brief Generates the whole deck in the presentation file format
+ */
+std::string generateDeckText(const DeckSpec& spec);
+
+} // namespace bench
+
+#endif // DECKGENERATOR_H
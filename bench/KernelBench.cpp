@@ -0,0 +1,110 @@
+#include "Bench.h"
+#include "Canvas.h"
+#include "Color.h"
+#include "PixelKernels.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+// One 1080p frame per iteration
+constexpr int kFrameWidth = 1920;
+constexpr int kFrameHeight = 1080;
+constexpr size_t kFramePixels = static_cast<size_t>(kFrameWidth) * kFrameHeight;
+constexpr uint64_t kFrameBytes = kFramePixels * sizeof(Color);
+
+/**
+ * @brief Runs body with the kernels forced to level, restoring the default after
+ */
+template <typename Body>
+void runAtLevel(bench::State& state, PixelKernels::Level level, Body body) {
+    PixelKernels::Level previous = PixelKernels::getLevel();
+    if (!PixelKernels::setLevel(level)) {
+        state.skip("not supported by this CPU");
+        return;
+    }
+    body();
+    state.setBytesProcessed(state.getIterations() * kFrameBytes);
+    PixelKernels::setLevel(previous);
+}
+
+void benchFill(bench::State& state, PixelKernels::Level level) {
+    std::vector<Color> frame(kFramePixels);
+    runAtLevel(state, level, [&]() {
+        while (state.keepRunning()) {
+            PixelKernels::fill(frame.data(), frame.size(), Color::Teal());
+            bench::doNotOptimize(frame);
+        }
+    });
+}
+
+void benchClear(bench::State& state, PixelKernels::Level level) {
+    Canvas canvas(kFrameWidth, kFrameHeight);
+    runAtLevel(state, level, [&]() {
+        while (state.keepRunning()) {
+            canvas.clear();
+            bench::doNotOptimize(canvas);
+        }
+    });
+}
+
+void benchRgbToBgr(bench::State& state, PixelKernels::Level level) {
+    std::vector<Color> frame(kFramePixels);
+    for (size_t i = 0; i < frame.size(); ++i) {
+        frame[i] = Color(static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i >> 16));
+    }
+    std::vector<uint8_t> out(kFramePixels * 3);
+    runAtLevel(state, level, [&]() {
+        while (state.keepRunning()) {
+            PixelKernels::rgbToBgr(frame.data(), out.data(), frame.size());
+            bench::doNotOptimize(out);
+        }
+    });
+}
+
+void benchBlend(bench::State& state, PixelKernels::Level level) {
+    std::vector<Color> frame(kFramePixels, Color(30, 30, 40));
+    std::vector<uint8_t> alpha(kFramePixels);
+    for (size_t i = 0; i < alpha.size(); ++i) {
+        alpha[i] = static_cast<uint8_t>(i * 17);
+    }
+    runAtLevel(state, level, [&]() {
+        while (state.keepRunning()) {
+            PixelKernels::blendCoverage(frame.data(), alpha.data(), frame.size(), Color::Orange());
+            bench::doNotOptimize(frame);
+        }
+    });
+}
+
+void benchBlendSolid(bench::State& state, PixelKernels::Level level) {
+    std::vector<Color> frame(kFramePixels, Color(30, 30, 40));
+    runAtLevel(state, level, [&]() {
+        while (state.keepRunning()) {
+            PixelKernels::blendSolid(frame.data(), frame.size(), Color::Orange().withAlpha(96));
+            bench::doNotOptimize(frame);
+        }
+    });
+}
+
+/**
+ * @brief Registers every kernel once per instruction set level
+ */
+bool registerKernelBenchmarks() {
+    const PixelKernels::Level levels[] = {
+        PixelKernels::SCALAR, PixelKernels::SSSE3, PixelKernels::AVX2
+    };
+    for (PixelKernels::Level level : levels) {
+        std::string suffix = std::string("/") + PixelKernels::getLevelName(level);
+        bench::registerBenchmark("KernelFill" + suffix, [level](bench::State& s) { benchFill(s, level); });
+        bench::registerBenchmark("KernelClear" + suffix, [level](bench::State& s) { benchClear(s, level); });
+        bench::registerBenchmark("KernelRgbToBgr" + suffix, [level](bench::State& s) { benchRgbToBgr(s, level); });
+        bench::registerBenchmark("KernelBlend" + suffix, [level](bench::State& s) { benchBlend(s, level); });
+        bench::registerBenchmark("KernelBlendSolid" + suffix, [level](bench::State& s) { benchBlendSolid(s, level); });
+    }
+    return true;
+}
+
+[[maybe_unused]] const bool kernelBenchmarksRegistered = registerKernelBenchmarks();
+
+} // namespace
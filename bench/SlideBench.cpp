@@ -0,0 +1,399 @@
+#include "Bench.h"
+#include "DeckGenerator.h"
+#include "Canvas.h"
+#include "Slide.h"
+#include "SlideShow.h"
+#include "SvgWriter.h"
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace {
+
+// Deck presets; edit these to change the shape mix, count or canvas size
+bench::DeckSpec mixedSpec() {
+    bench::DeckSpec spec;
+    spec.shapesPerSlide = 50;
+    return spec;
+}
+
+bench::DeckSpec largeSpec() {
+    bench::DeckSpec spec;
+    spec.shapesPerSlide = 200;
+    spec.canvasWidth = 1920;
+    spec.canvasHeight = 1080;
+    return spec;
+}
+
+bench::DeckSpec polygonSpec() {
+    bench::DeckSpec spec;
+    spec.shapesPerSlide = 50;
+    spec.shapeMix = "Star:2, Hexagon, Pentagon, Triangle, Trapezoid";
+    return spec;
+}
+
+bench::DeckSpec fileSpec() {
+    bench::DeckSpec spec;
+    spec.slides = 20;
+    spec.shapesPerSlide = 50;
+    return spec;
+}
+
+bench::DeckSpec saveDeckSpec() {
+    bench::DeckSpec spec;
+    spec.slides = 2000;
+    spec.shapesPerSlide = 20;
+    return spec;
+}
+
+bench::DeckSpec bulkEditSpec() {
+    bench::DeckSpec spec;
+    spec.shapesPerSlide = 5000;
+    return spec;
+}
+
+bench::DeckSpec jsonDeckSpec() {
+    bench::DeckSpec spec;
+    spec.slides = 10000;
+    spec.shapesPerSlide = 10;
+    return spec;
+}
+
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("slideshow_bench_" + name)).string();
+}
+
+uint64_t fileSize(const std::string& path) {
+    std::error_code error;
+    auto size = std::filesystem::file_size(path, error);
+    return error ? 0 : static_cast<uint64_t>(size);
+}
+
+/**
+ * @brief Discards console output (e.g. the loader's status lines) while in scope
+ */
+class ScopedSilence {
+private:
+    std::ostringstream sink;
+    std::streambuf* savedOut;
+    std::streambuf* savedErr;
+
+public:
+    ScopedSilence() : savedOut(std::cout.rdbuf(sink.rdbuf())), savedErr(std::cerr.rdbuf(sink.rdbuf())) {}
+    ~ScopedSilence() {
+        std::cout.rdbuf(savedOut);
+        std::cerr.rdbuf(savedErr);
+    }
+
+    void clear() { sink.str(std::string()); }
+};
+
+SlideShow generateSlideShow(const bench::DeckSpec& spec) {
+    SlideShow slideshow("bench_deck.txt");
+    for (int i = 0; i < spec.slides; ++i) {
+        slideshow.addSlide(bench::generateSlide(spec, i));
+    }
+    return slideshow;
+}
+
+void exportSlideShowJSON(bench::State& state, bool pretty) {
+    SlideShow slideshow = generateSlideShow(jsonDeckSpec());
+    std::string path = tempPath("deck.json");
+    bool ok = true;
+    while (state.keepRunning()) {
+        ok = slideshow.exportSlideshowJSON(path, pretty) && ok;
+    }
+    if (!ok) {
+        state.skip("cannot write " + path);
+    } else {
+        state.setBytesProcessed(state.getIterations() * fileSize(path));
+    }
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief Loads the deck at path repeatedly, then deletes it
+ */
+void loadDeck(bench::State& state, const std::string& path, bool json) {
+    int slides = 0;
+    {
+        ScopedSilence silence;
+        while (state.keepRunning()) {
+            auto slideshow = json ? SlideShow::loadJSON(path) : SlideShow::load(path);
+            slides += slideshow ? slideshow->getTotalSlides() : 0;
+            silence.clear();
+        }
+    }
+    state.setBytesProcessed(state.getIterations() * fileSize(path));
+    bench::doNotOptimize(slides);
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief Saves a loaded deck repeatedly, after editing one slide or after touching all of them
+ */
+void saveDeck(bench::State& state, bool oneSlideEdited) {
+    std::string path = tempPath("save.txt");
+    {
+        std::ofstream file(path);
+        file << bench::generateDeckText(saveDeckSpec());
+        if (!file) {
+            state.skip("cannot write " + path);
+            return;
+        }
+    }
+
+    std::unique_ptr<SlideShow> slideshow;
+    {
+        ScopedSilence silence;
+        slideshow = SlideShow::load(path);
+    }
+    bool ok = slideshow != nullptr;
+    while (ok && state.keepRunning()) {
+        if (oneSlideEdited) {
+            slideshow->markSlideModified(1);
+        } else {
+            slideshow->setModified(true);
+        }
+        ok = slideshow->save();
+    }
+    if (!ok) {
+        state.skip("cannot save " + path);
+    } else {
+        state.setBytesProcessed(state.getIterations() * fileSize(path));
+    }
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief Journals single-slide edits, letting the journal batch fsyncs or forcing one per edit
+ */
+void journalEdits(bench::State& state, bool syncEachEdit) {
+    std::string path = tempPath("journal.txt");
+    {
+        std::ofstream file(path);
+        file << bench::generateDeckText(saveDeckSpec());
+        if (!file) {
+            state.skip("cannot write " + path);
+            return;
+        }
+    }
+
+    std::unique_ptr<SlideShow> slideshow;
+    {
+        ScopedSilence silence;
+        slideshow = SlideShow::load(path);
+    }
+    bool ok = slideshow != nullptr;
+    if (ok) {
+        slideshow->enableJournal();
+    }
+    while (ok && state.keepRunning()) {
+        slideshow->markSlideModified(1);
+        if (syncEachEdit) {
+            ok = slideshow->syncJournal();
+        }
+    }
+    ok = ok && slideshow->syncJournal();
+    if (!ok) {
+        state.skip("cannot write the journal of " + path);
+    }
+    if (slideshow) {
+        slideshow->discardJournal();
+    }
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief Removes every other shape and appends them again, in bulk or one shape at a time
+ */
+void cycleShapes(bench::State& state, bool bulk) {
+    Slide slide = bench::generateSlide(bulkEditSpec());
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < slide.getShapeCount(); i += 2) {
+        indices.push_back(i);
+    }
+    std::vector<std::shared_ptr<Shape>> removed;
+    while (state.keepRunning()) {
+        removed.clear();
+        for (size_t index : indices) {
+            removed.push_back(slide.getShape(index));
+        }
+        if (bulk) {
+            slide.removeShapes(indices);
+            slide.addShapes(removed);
+        } else {
+            // Back to front, so the remaining indices stay valid
+            for (size_t i = indices.size(); i-- > 0;) {
+                slide.removeShape(indices[i]);
+            }
+            for (const auto& shape : removed) {
+                slide.addShape(shape);
+            }
+        }
+    }
+    bench::doNotOptimize(slide.getShapeCount());
+}
+
+void renderSlide(bench::State& state, const bench::DeckSpec& spec, bool antiAliased) {
+    Slide slide = bench::generateSlide(spec);
+    uint64_t checksum = 0;
+    while (state.keepRunning()) {
+        Canvas canvas = slide.render(antiAliased);
+        checksum += canvas.getPixel(spec.canvasWidth / 2, spec.canvasHeight / 2).r;
+    }
+    state.setBytesProcessed(state.getIterations() * static_cast<uint64_t>(spec.canvasWidth) *
+                            spec.canvasHeight * sizeof(Color));
+    bench::doNotOptimize(checksum);
+}
+
+} // namespace
+
+// ============== Slide::render ==============
+
+BENCHMARK(SlideRenderMixed) {
+    renderSlide(state, mixedSpec(), false);
+}
+
+BENCHMARK(SlideRenderMixedAA) {
+    renderSlide(state, mixedSpec(), true);
+}
+
+BENCHMARK(SlideRenderPolygons) {
+    renderSlide(state, polygonSpec(), false);
+}
+
+BENCHMARK(SlideRenderLarge) {
+    renderSlide(state, largeSpec(), false);
+}
+
+BENCHMARK(SlideRenderLargeAA) {
+    renderSlide(state, largeSpec(), true);
+}
+
+// ============== Text Exports ==============
+
+BENCHMARK(SlideToSVG) {
+    Slide slide = bench::generateSlide(largeSpec());
+    uint64_t bytes = 0;
+    while (state.keepRunning()) {
+        bytes += slide.toSVG().size();
+    }
+    state.setBytesProcessed(bytes);
+    bench::doNotOptimize(bytes);
+}
+
+BENCHMARK(SlideToSVGOptimized) {
+    Slide slide = bench::generateSlide(largeSpec());
+    uint64_t bytes = 0;
+    while (state.keepRunning()) {
+        bytes += slide.toSVG(true).size();
+    }
+    state.setBytesProcessed(bytes);
+    bench::doNotOptimize(bytes);
+}
+
+BENCHMARK(SlideToJSON) {
+    Slide slide = bench::generateSlide(largeSpec());
+    uint64_t bytes = 0;
+    while (state.keepRunning()) {
+        bytes += slide.toJSON().size();
+    }
+    state.setBytesProcessed(bytes);
+    bench::doNotOptimize(bytes);
+}
+
+// ============== Bulk Shape Edits ==============
+
+BENCHMARK(SlideRemoveShapesOneByOne) {
+    cycleShapes(state, false);
+}
+
+BENCHMARK(SlideRemoveShapesBulk) {
+    cycleShapes(state, true);
+}
+
+// ============== File I/O ==============
+
+BENCHMARK(CanvasExportBMP) {
+    bench::DeckSpec spec = largeSpec();
+    Canvas canvas = bench::generateSlide(spec).render(true);
+    std::string path = tempPath("export.bmp");
+    bool ok = true;
+    while (state.keepRunning()) {
+        ok = canvas.exportBMP(path) && ok;
+    }
+    if (!ok) {
+        state.skip("cannot write " + path);
+    } else {
+        state.setBytesProcessed(state.getIterations() * fileSize(path));
+    }
+    std::remove(path.c_str());
+}
+
+BENCHMARK(SlideExportSVG) {
+    Slide slide = bench::generateSlide(largeSpec());
+    std::string path = tempPath("export.svg");
+    SvgWriter writer;
+    bool ok = true;
+    while (state.keepRunning()) {
+        ok = slide.exportSVG(path, writer) && ok;
+    }
+    if (!ok) {
+        state.skip("cannot write " + path);
+    } else {
+        state.setBytesProcessed(state.getIterations() * fileSize(path));
+    }
+    std::remove(path.c_str());
+}
+
+BENCHMARK(SlideShowExportJSON) {
+    exportSlideShowJSON(state, true);
+}
+
+BENCHMARK(SlideShowExportJSONCompact) {
+    exportSlideShowJSON(state, false);
+}
+
+BENCHMARK(SlideShowSave) {
+    saveDeck(state, false);
+}
+
+BENCHMARK(SlideShowSaveOneEdit) {
+    saveDeck(state, true);
+}
+
+BENCHMARK(SlideShowJournalEdit) {
+    journalEdits(state, false);
+}
+
+BENCHMARK(SlideShowJournalEditSynced) {
+    journalEdits(state, true);
+}
+
+BENCHMARK(SlideShowLoad) {
+    std::string path = tempPath("deck.txt");
+    {
+        std::ofstream file(path);
+        file << bench::generateDeckText(fileSpec());
+        if (!file) {
+            state.skip("cannot write " + path);
+            return;
+        }
+    }
+    loadDeck(state, path, false);
+}
+
+BENCHMARK(SlideShowLoadJSON) {
+    std::string path = tempPath("deck.json");
+    if (!generateSlideShow(fileSpec()).exportSlideshowJSON(path)) {
+        state.skip("cannot write " + path);
+        return;
+    }
+    loadDeck(state, path, true);
+}
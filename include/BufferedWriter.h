@@ -0,0 +1,102 @@
+#ifndef BUFFEREDWRITER_H
+#define BUFFEREDWRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+/**
+ * @brief Text sink that formats straight into one reusable buffer
+ * When a file is open the buffer is written out in large blocks; in counting
+ * mode each block is dropped and only its length kept; otherwise the text
+ * accumulates in memory until takeString(). The buffer keeps its
+ * capacity across open()/close(), so one writer can export a whole deck.
+ */
+class BufferedWriter {
+public:
+    /**
+     * @brief Bytes buffered before a block is written to the file
+     */
+    static constexpr size_t kDefaultCapacity = 64 * 1024;
+
+    explicit BufferedWriter(size_t capacity = kDefaultCapacity);
+    virtual ~BufferedWriter();
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    /**
+     * @brief Starts writing to a file, closing any previous one
+     * @return True if the file could be opened
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * @brief Flushes and closes the current file
+     * @return True if every write since open() succeeded
+     */
+    bool close();
+
+    bool isOpen() const { return file.is_open(); }
+
+    /**
+     * @brief Closes any file and from now on only counts the bytes written
+     * Counting lasts until open() or takeString(); read the total with getBytesWritten().
+     */
+    void startCounting();
+
+    /**
+     * @brief Returns the text written since the last call (in-memory mode)
+     */
+    std::string takeString();
+
+    void write(char c) {
+        buffer.push_back(c);
+        if (buffer.size() >= capacity) flush();
+    }
+
+    void write(const char* text, size_t length) {
+        buffer.append(text, length);
+        if (buffer.size() >= capacity) flush();
+    }
+
+    void write(const std::string& text) { write(text.data(), text.size()); }
+
+    /**
+     * @brief Writes a string literal without measuring it at run time
+     */
+    template <size_t N>
+    void write(const char (&text)[N]) { write(text, N - 1); }
+
+    /**
+     * @brief Writes a decimal integer
+     */
+    void writeInt(int64_t value);
+
+    /**
+     * @brief Writes a double the way std::ostream does by default (%g, 6 digits)
+     */
+    void writeDouble(double value);
+
+    /**
+     * @brief Gets the bytes written since open(), startCounting() or takeString()
+     */
+    uint64_t getBytesWritten() const { return bytesFlushed + buffer.size(); }
+
+protected:
+    /**
+     * @brief Writes the buffered block to the file (no-op in memory mode)
+     * In counting mode the block is dropped after adding it to the total.
+     */
+    void flush();
+
+private:
+    std::string buffer;
+    size_t capacity;
+    std::ofstream file;
+    uint64_t bytesFlushed;
+    bool counting;
+};
+
+#endif // BUFFEREDWRITER_H
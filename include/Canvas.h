@@ -4,6 +4,7 @@
 #include <vector>
 #include <string>
 #include <fstream>
+#include <cstdint>
 #include "Color.h"
 
 /**
@@ -14,10 +15,9 @@ class Canvas {
 private:
     int width;
     int height;
-    std::vector<std::vector<Color>> pixels;
-    std::vector<std::vector<char>> asciiBuffer;
-    std::vector<std::vector<Color>> asciiFgColors;
+    std::vector<Color> pixels;  // Row-major, width * height
     Color backgroundColor;
+    bool antiAliased;
 
 public:
     /**
@@ -32,18 +32,41 @@ public:
 
     /**
      * @brief Sets a pixel at (x, y) with given color
+     * Translucent colors are blended over the existing pixel.
      */
     void setPixel(int x, int y, const Color& color);
 
     /**
-     * @brief Gets pixel color at (x, y)
+     * @brief Blends a color over the pixel at (x, y) with the given coverage
+     * The coverage is scaled by the color's own alpha.
+     * @param alpha 0 leaves the pixel unchanged, 255 replaces it
      */
-    Color getPixel(int x, int y) const;
+    void blendPixel(int x, int y, const Color& color, uint8_t alpha);
+
+    /**
+     * @brief Fills the horizontal run [x1, x2] on row y, clipped to the canvas
+     * Translucent colors are blended rather than stored.
+     */
+    void fillSpan(int y, int x1, int x2, const Color& color);
+
+    /**
+     * @brief Blends a color over count pixels of row y starting at x
+     * @param alpha Per-pixel coverage with the color's alpha already folded in
+     */
+    void blendSpan(int y, int x, const uint8_t* alpha, int count, const Color& color);
+
+    /**
+     * @brief Enables coverage-based anti-aliasing for subsequent primitives
+     * Circles, ellipses, polygons and lines are sampled 4x4 per pixel and
+     * blended; axis-aligned rectangles are already exact and stay opaque.
+     */
+    void setAntiAliasing(bool enabled) { antiAliased = enabled; }
+    bool isAntiAliased() const { return antiAliased; }
 
     /**
-     * @brief Sets an ASCII character at scaled position
+     * @brief Gets pixel color at (x, y)
      */
-    void setAscii(int x, int y, char ch, const Color& color);
+    Color getPixel(int x, int y) const;
 
     /**
      * @brief Draws a filled rectangle
@@ -70,8 +93,14 @@ public:
      */
     void fillEllipse(int cx, int cy, int rx, int ry, const Color& color);
 
+    /**
+     * @brief Draws an ellipse outline of the given thickness
+     */
+    void drawEllipse(int cx, int cy, int rx, int ry, const Color& color, int thickness = 1);
+
     /**
      * @brief Draws a line between two points
+     * Lines thicker than one pixel are stroked as a polygon with round caps.
      */
     void drawLine(int x1, int y1, int x2, int y2, const Color& color, int thickness = 1);
 
@@ -87,6 +116,8 @@ public:
 
     /**
      * @brief Draws polygon outline
+     * Thick outlines are stroked in one pass with round joins, so every
+     * pixel is written once.
      */
     void drawPolygon(const std::vector<std::pair<int, int>>& points, const Color& color, int thickness = 1);
 
@@ -99,6 +130,9 @@ public:
 
     /**
      * @brief Returns the canvas as ASCII art string with ANSI colors
+     * The preview is derived from the framebuffer on demand: each character
+     * covers a 2x4 pixel cell and shows the cell's most common non-background
+     * color, so raster-only rendering never pays for it.
      */
     std::string toAsciiArt() const;
 
@@ -107,14 +141,42 @@ public:
      */
     void displayAscii() const;
 
+    /**
+     * @brief Gets the majority non-background color of preview cell (ax, ay)
+     * @return False if every pixel in the cell is background
+     */
+    bool sampleAsciiCell(int ax, int ay, Color& out) const;
+
     // Getters
     int getWidth() const { return width; }
     int getHeight() const { return height; }
+    int getAsciiWidth() const { return width / kAsciiCellWidth; }
+    int getAsciiHeight() const { return height / kAsciiCellHeight; }
 
 private:
+    // Pixels per ASCII preview character
+    static constexpr int kAsciiCellWidth = 2;
+    static constexpr int kAsciiCellHeight = 4;
+
     // Helper for point-in-polygon test
     bool pointInPolygon(int x, int y, const std::vector<std::pair<int, int>>& points) const;
     
+    // Per-row half widths of the integer region a*dx^2 + b*dy^2 <= c (-1 = empty row)
+    static void quadricHalfWidths(int64_t a, int64_t b, int64_t c, int rows, int maxX,
+                                  std::vector<int>& out);
+
+    // Fills rows symmetric about cy between the outer and (optional) inner half widths
+    void fillRing(int cx, int cy, const std::vector<int>& outer, const std::vector<int>& inner,
+                  const Color& color);
+
+    // Strokes a polyline (closed when requested) using merged per-row spans
+    void drawPolygonStroke(const std::vector<std::pair<int, int>>& points, bool closed,
+                           const Color& color, int thickness);
+
+    // Anti-aliased fills (inner radii <= 0 give a solid ellipse)
+    void fillEllipseAA(int cx, int cy, int rx, int ry, int irx, int iry, const Color& color);
+    void fillPolygonAA(const std::vector<std::pair<int, int>>& points, const Color& color);
+
     // Helper for triangle fill
     void fillFlatBottomTriangle(int x1, int y1, int x2, int y2, int x3, int y3, const Color& color);
     void fillFlatTopTriangle(int x1, int y1, int x2, int y2, int x3, int y3, const Color& color);
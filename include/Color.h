@@ -2,35 +2,100 @@
 #define COLOR_H
 
 #include <string>
-#include <map>
+#include <string_view>
+#include <cstddef>
 #include <cstdint>
+#include <ostream>
 #include <vector>
 
 /**
- * @brief Represents an RGB color with ANSI terminal support
+ * @brief One ANSI color escape held by value, without heap allocation
+ * Streams with operator<< and converts to std::string where one is needed.
  */
-class Color {
+class AnsiEscape {
 public:
-    uint8_t r, g, b;
+    static constexpr size_t kCapacity = 20;  // "\033[38;2;255;255;255m" is 19 bytes
+
+    const char* data() const { return text; }
+    size_t size() const { return length; }
+    std::string_view view() const { return std::string_view(text, length); }
+    operator std::string() const { return std::string(text, length); }
+
+    AnsiEscape& operator+=(char c) {
+        text[length++] = c;
+        return *this;
+    }
+
+    AnsiEscape& operator+=(const char* suffix) {
+        while (*suffix) text[length++] = *suffix++;
+        return *this;
+    }
+
+private:
+    char text[kCapacity] = {};
+    uint8_t length = 0;
+};
+
+inline std::ostream& operator<<(std::ostream& out, const AnsiEscape& escape) {
+    return out.write(escape.data(), static_cast<std::streamsize>(escape.size()));
+}
+
+/**
+ * @brief Represents an RGBA color with ANSI terminal support
+ * Four bytes (r, g, b, a) packed into one aligned 32-bit word, so a row of
+ * colors is directly usable as a framebuffer. Alpha 255 is opaque.
+ */
+class alignas(4) Color {
+public:
+    uint8_t r, g, b, a;
 
     // Default constructor - white
-    Color() : r(255), g(255), b(255) {}
+    constexpr Color() : r(255), g(255), b(255), a(255) {}
     
-    // RGB constructor
-    Color(uint8_t red, uint8_t green, uint8_t blue) : r(red), g(green), b(blue) {}
+    // RGB(A) constructor
+    constexpr Color(uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha = 255)
+        : r(red), g(green), b(blue), a(alpha) {}
 
-    // Named color constructor
+    /**
+     * @brief Parses a color, falling back to white if it is not recognized
+     * Accepts a name ("red"), "#RRGGBB", "#RRGGBBAA", "RGB(r,g,b)" or
+     * "RGBA(r,g,b,a)". A name or hex color may end in "@alpha", given as
+     * 0-255 or as a percentage ("red@50%").
+     */
     explicit Color(const std::string& colorName);
 
+    /**
+     * @brief Checks whether the color is fully opaque
+     */
+    bool isOpaque() const { return a == 255; }
+
+    /**
+     * @brief Gets the same color with a different alpha
+     */
+    constexpr Color withAlpha(uint8_t alpha) const { return Color(r, g, b, alpha); }
+
     /**
      * @brief Gets ANSI escape code for foreground color
+     * Escapes are cached in a small per-thread table, so repeated UI colors
+     * are copied rather than formatted again.
      */
-    std::string toAnsiFg() const;
+    AnsiEscape toAnsiFg() const;
 
     /**
      * @brief Gets ANSI escape code for background color
      */
-    std::string toAnsiBg() const;
+    AnsiEscape toAnsiBg() const;
+
+    /**
+     * @brief Appends the foreground escape to out without caching or temporaries
+     * Meant for loops over arbitrary pixel colors, such as preview rendering.
+     */
+    void appendAnsiFg(std::string& out) const;
+
+    /**
+     * @brief Appends the background escape to out without caching or temporaries
+     */
+    void appendAnsiBg(std::string& out) const;
 
     /**
      * @brief Resets ANSI color
@@ -38,44 +103,50 @@ public:
     static std::string resetAnsi();
 
     /**
-     * @brief Gets color name if it's a known color
+     * @brief Gets color name if it's a known color, otherwise "RGB(r,g,b)"
+     * Translucent colors get "@alpha" after the name, or "RGBA(r,g,b,a)"
+     * if unnamed.
      */
     std::string getName() const;
 
+    /**
+     * @brief Gets a comma-free form that Color(const std::string&) parses back
+     * Named colors keep their name (plus "@alpha" if translucent); others are
+     * written as "#RRGGBB" or "#RRGGBBAA".
+     */
+    std::string toString() const;
+
     /**
      * @brief Checks if two colors are equal
      */
     bool operator==(const Color& other) const;
 
     // Predefined colors
-    static Color Red()     { return Color(255, 60, 60); }
-    static Color Green()   { return Color(60, 255, 60); }
-    static Color Blue()    { return Color(60, 120, 255); }
-    static Color Yellow()  { return Color(255, 255, 60); }
-    static Color Cyan()    { return Color(60, 255, 255); }
-    static Color Magenta() { return Color(255, 60, 255); }
-    static Color Orange()  { return Color(255, 165, 0); }
-    static Color Purple()  { return Color(160, 60, 255); }
-    static Color Pink()    { return Color(255, 150, 200); }
-    static Color White()   { return Color(255, 255, 255); }
-    static Color Black()   { return Color(0, 0, 0); }
-    static Color Gray()    { return Color(128, 128, 128); }
-    static Color Brown()   { return Color(139, 90, 43); }
-    static Color Gold()    { return Color(255, 215, 0); }
-    static Color Silver()  { return Color(192, 192, 192); }
-    static Color Navy()    { return Color(30, 60, 150); }
-    static Color Teal()    { return Color(60, 180, 180); }
-    static Color Lime()    { return Color(180, 255, 60); }
-    static Color Coral()   { return Color(255, 127, 80); }
-    static Color Violet()  { return Color(200, 130, 255); }
+    static constexpr Color Red()     { return Color(255, 60, 60); }
+    static constexpr Color Green()   { return Color(60, 255, 60); }
+    static constexpr Color Blue()    { return Color(60, 120, 255); }
+    static constexpr Color Yellow()  { return Color(255, 255, 60); }
+    static constexpr Color Cyan()    { return Color(60, 255, 255); }
+    static constexpr Color Magenta() { return Color(255, 60, 255); }
+    static constexpr Color Orange()  { return Color(255, 165, 0); }
+    static constexpr Color Purple()  { return Color(160, 60, 255); }
+    static constexpr Color Pink()    { return Color(255, 150, 200); }
+    static constexpr Color White()   { return Color(255, 255, 255); }
+    static constexpr Color Black()   { return Color(0, 0, 0); }
+    static constexpr Color Gray()    { return Color(128, 128, 128); }
+    static constexpr Color Brown()   { return Color(139, 90, 43); }
+    static constexpr Color Gold()    { return Color(255, 215, 0); }
+    static constexpr Color Silver()  { return Color(192, 192, 192); }
+    static constexpr Color Navy()    { return Color(30, 60, 150); }
+    static constexpr Color Teal()    { return Color(60, 180, 180); }
+    static constexpr Color Lime()    { return Color(180, 255, 60); }
+    static constexpr Color Coral()   { return Color(255, 127, 80); }
+    static constexpr Color Violet()  { return Color(200, 130, 255); }
 
     /**
      * @brief Gets list of all available color names
      */
     static std::vector<std::string> getAvailableColors();
-
-private:
-    static const std::map<std::string, Color>& getColorMap();
 };
 
 #endif // COLOR_H
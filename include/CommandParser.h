@@ -28,6 +28,10 @@ public:
         EDIT,
         LIST,
         CLEAR,
+        MOVE,
+        SCALE,
+        RECOLOR,
+        DUPLICATE,
         
         // Slide manipulation
         NEWSLIDE,
@@ -58,6 +62,7 @@ public:
         HISTORY,
         
         // System commands
+        STATS,
         HELP,
         EXIT,
         
@@ -75,6 +80,7 @@ public:
 
     /**
      * @brief Parses a command string into a Command structure
+     * Command words and aliases are resolved through a compile-time perfect hash table.
      * @param input The raw input string from the user
      * @return A Command structure with type and arguments
      */
@@ -0,0 +1,107 @@
+#ifndef EDITJOURNAL_H
+#define EDITJOURNAL_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Append-only log of slide edits kept next to a deck ("<deck>.journal")
+ * Every edit appends one record holding the edited slide's new content, so
+ * a session that ends without saving can be rebuilt from the deck file plus
+ * its journal. Records are buffered and made durable in groups: commit()
+ * writes everything pending with one write and one fsync. append() only
+ * commits by itself when kCommitBytes are waiting or the oldest pending
+ * record is kCommitInterval old, so the caller must commit() once its
+ * current unit of work is done; the CLI does so after every command.
+ * Each record carries a CRC-32, so a record torn by a crash is detected
+ * and dropped on replay.
+ *
+ * The header stores the deck file's size and modification time when the
+ * journal was started; a journal whose deck has since been saved or changed
+ * is not replayed.
+ */
+class EditJournal {
+public:
+    enum class Op : uint8_t {
+        SetSlide = 'S',     // Payload is the slide's compact JSON
+        InsertSlide = 'I',  // Empty slide inserted at the slide number
+        RemoveSlide = 'R'   // Slide removed
+    };
+
+    struct Record {
+        Op op;
+        int slideNumber;           // 1-based
+        std::string_view payload;  // Valid only during the replay callback
+    };
+
+    static constexpr size_t kCommitBytes = 256 * 1024;
+    static constexpr std::chrono::milliseconds kCommitInterval{50};
+
+    explicit EditJournal(const std::string& deckFilename);
+
+    /**
+     * @brief Commits pending records and closes the file
+     */
+    ~EditJournal();
+
+    EditJournal(const EditJournal&) = delete;
+    EditJournal& operator=(const EditJournal&) = delete;
+
+    static std::string pathFor(const std::string& deckFilename);
+
+    const std::string& getPath() const { return path; }
+
+    /**
+     * @brief Queues a record; the journal file is created on the first one
+     */
+    void append(Op op, int slideNumber, std::string_view payload = std::string_view());
+
+    /**
+     * @brief Writes pending records and waits until they are on disk
+     * @return True if nothing was pending or every record was written
+     */
+    bool commit();
+
+    /**
+     * @brief Drops pending records and deletes the journal file
+     * Called once the deck has been saved and the journal is no longer needed.
+     */
+    void discard();
+
+    /**
+     * @brief Reads the journal left by an earlier session
+     * Records superseded by a later SetSlide of the same slide are skipped.
+     * Replay stops at the first damaged record or when apply returns false.
+     * In the latter case each slide still receives its newest content from
+     * before the failed record, and later appends replace that record.
+     * @param apply Called for each record, in order
+     * @return Number of records applied, or -1 if the journal belongs to a different deck state
+     */
+    int replay(const std::function<bool(const Record&)>& apply);
+
+    /**
+     * @brief Gets the number of records not yet committed
+     */
+    size_t getPendingCount() const { return pendingCount; }
+
+private:
+    std::string deckFilename;
+    std::string path;
+    std::string header;   // Identifies the deck state the records apply to
+    int fd;
+    uint64_t resumeSize;  // Bytes of a replayed journal to keep when reopening
+    std::string pending;  // Encoded records not yet written
+    size_t pendingCount;
+    std::chrono::steady_clock::time_point firstPendingTime;
+    bool writeFailed;     // An automatic commit failed since the last commit()
+
+    bool openFile();
+    void closeFile();
+    std::string makeHeader() const;
+};
+
+#endif // EDITJOURNAL_H
@@ -0,0 +1,30 @@
+#ifndef FILESYNC_H
+#define FILESYNC_H
+
+#include <string>
+
+/**
+ * @brief Flushes files and directory entries through to the disk
+ * On Windows directory entries are durable once a rename returns, so
+ * syncParentDirectory() has nothing to do there.
+ */
+class FileSync {
+public:
+    /**
+     * @brief Waits until everything written through the descriptor is on disk
+     */
+    static bool syncDescriptor(int fd);
+
+    /**
+     * @brief Waits until the file's contents are on disk
+     * @return False if the file cannot be opened or flushed
+     */
+    static bool syncFile(const std::string& path);
+
+    /**
+     * @brief Makes a created, renamed or replaced file's directory entry durable
+     */
+    static bool syncParentDirectory(const std::string& path);
+};
+
+#endif // FILESYNC_H
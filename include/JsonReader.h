@@ -0,0 +1,66 @@
+#ifndef JSONREADER_H
+#define JSONREADER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Single-pass, event-driven (SAX-style) JSON parser
+ * The parser walks the text once and reports each token to a Handler instead
+ * of building a document tree. Keys and strings without escapes are passed as
+ * views into the input; escaped ones are decoded into one reused buffer, so a
+ * parse allocates almost nothing beyond what the handler keeps.
+ */
+class JsonReader {
+public:
+    /**
+     * @brief Receives parse events; returning false stops the parse
+     * Views passed to key() and string() are only valid during the call.
+     */
+    class Handler {
+    public:
+        virtual ~Handler() = default;
+
+        virtual bool beginObject() { return true; }
+        virtual bool endObject() { return true; }
+        virtual bool beginArray() { return true; }
+        virtual bool endArray() { return true; }
+        virtual bool key(std::string_view) { return true; }
+        virtual bool string(std::string_view) { return true; }
+        virtual bool number(double) { return true; }
+        virtual bool boolean(bool) { return true; }
+        virtual bool null() { return true; }
+    };
+
+    /**
+     * @brief Parses one JSON document
+     * @return True if the text is valid JSON and no handler call returned false
+     */
+    bool parse(std::string_view text, Handler& handler);
+
+    /**
+     * @brief Describes why the last parse failed, e.g. "line 3, column 7: expected ':'"
+     */
+    const std::string& getError() const { return error; }
+
+private:
+    std::string_view input;
+    size_t pos = 0;
+    std::vector<char> containers;  // '{' or '[' for each open container
+    std::string scratch;           // Decoded text of escaped strings
+    std::string error;
+
+    void skipWhitespace();
+    bool parseValue(Handler& handler);
+    bool parseKey(Handler& handler);
+    bool parseString(std::string_view& text);
+    bool parseLiteral(std::string_view literal);
+    bool parseNumber(Handler& handler);
+    bool closeContainer(Handler& handler);
+    bool fail(const char* message);
+    bool stopped();
+};
+
+#endif // JSONREADER_H
@@ -0,0 +1,85 @@
+#ifndef JSONWRITER_H
+#define JSONWRITER_H
+
+#include "BufferedWriter.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief BufferedWriter that streams JSON values, compact or pretty-printed
+ * Containers are opened and closed explicitly and the writer places commas,
+ * newlines and indentation itself, so nested objects are written in place
+ * instead of being built as strings and re-indented by their parent:
+ *
+ *     out.beginObject();
+ *     out.member("x", 10);
+ *     out.key("shapes");
+ *     out.beginArray();
+ *     ...
+ *     out.endArray();
+ *     out.endObject();
+ *
+ * Pretty mode indents by two spaces per level; compact mode writes no
+ * whitespace at all.
+ */
+class JsonWriter : public BufferedWriter {
+public:
+    using BufferedWriter::BufferedWriter;
+
+    void setPretty(bool enabled) { pretty = enabled; }
+    bool isPretty() const { return pretty; }
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    /**
+     * @brief Writes an object member name; the next call writes its value
+     * Names are literals in the code and are written without escaping.
+     */
+    template <size_t N>
+    void key(const char (&name)[N]) {
+        beginValue();
+        write('"');
+        write(name, N - 1);
+        endKey();
+    }
+
+    void value(int64_t number);
+    void value(int number) { value(static_cast<int64_t>(number)); }
+    void value(double number);
+    void value(bool flag);
+
+    /**
+     * @brief Writes a quoted string, escaping quotes, backslashes and control characters
+     */
+    void value(const std::string& text);
+    void value(const char* text);
+
+    template <size_t N, typename T>
+    void member(const char (&name)[N], const T& memberValue) {
+        key(name);
+        value(memberValue);
+    }
+
+    /**
+     * @brief Forgets any unclosed containers so the next value starts a new document
+     */
+    void reset();
+
+private:
+    bool pretty = true;
+    bool afterKey = false;
+    std::vector<bool> hasItems;  // One entry per open container
+
+    void beginValue();
+    void endKey();
+    void openContainer(char bracket);
+    void closeContainer(char bracket);
+    void newline();
+    void writeEscaped(const char* text, size_t length);
+};
+
+#endif // JSONWRITER_H
@@ -0,0 +1,72 @@
+#ifndef PIXELKERNELS_H
+#define PIXELKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include "Color.h"
+
+/**
+ * @brief Bulk pixel operations with SIMD implementations
+ * Every kernel has a scalar version plus SSSE3 and AVX2 versions on x86.
+ * The best level the CPU supports is picked at runtime on first use; all
+ * levels produce bit-identical results.
+ */
+class PixelKernels {
+public:
+    /**
+     * @brief Instruction set levels, lowest to highest
+     */
+    enum Level {
+        SCALAR,
+        SSSE3,
+        AVX2
+    };
+
+    /**
+     * @brief Fills count pixels with one color (alpha included, no blending)
+     */
+    static void fill(Color* dst, size_t count, const Color& color);
+
+    /**
+     * @brief Converts count RGBA pixels to BGR bytes (BMP row order)
+     * @param dst Output buffer of at least count * 3 bytes; alpha is dropped
+     */
+    static void rgbToBgr(const Color* src, uint8_t* dst, size_t count);
+
+    /**
+     * @brief Blends one color over count pixels with per-pixel coverage
+     * The color is treated as opaque; scale the coverage by its alpha first.
+     * @param alpha One value per pixel, 0 = keep dst, 255 = replace with color
+     */
+    static void blendCoverage(Color* dst, const uint8_t* alpha, size_t count, const Color& color);
+
+    /**
+     * @brief Blends one color over count pixels using the color's own alpha
+     */
+    static void blendSolid(Color* dst, size_t count, const Color& color);
+
+    /**
+     * @brief Gets the level currently used by the kernels
+     */
+    static Level getLevel();
+
+    /**
+     * @brief Forces a level (e.g. to compare implementations)
+     * Safe while other threads render: each kernel call uses either the old
+     * or the new level throughout.
+     * @return False if the CPU does not support the requested level
+     */
+    static bool setLevel(Level level);
+
+    /**
+     * @brief Gets the highest level supported by this CPU
+     */
+    static Level detectLevel();
+
+    /**
+     * @brief Gets a printable name for a level
+     */
+    static const char* getLevelName(Level level);
+};
+
+#endif // PIXELKERNELS_H
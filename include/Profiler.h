@@ -0,0 +1,140 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Counts and times hot operations (loading, rendering, canvas primitives, exports, undo)
+ * Recording is off until enabled; a disabled timer costs one relaxed atomic
+ * load. Building with SLIDESHOW_NO_PROFILING removes the timers entirely.
+ * Safe to use from several threads.
+ */
+class Profiler {
+public:
+    /**
+     * @brief Instrumented operations
+     */
+    enum Operation {
+        // Presentation files
+        LOAD,
+        SAVE,
+        JOURNAL_COMMIT,
+        JOURNAL_REPLAY,
+
+        // Rendering
+        SLIDE_RENDER,
+        CANVAS_FILL_RECT,
+        CANVAS_DRAW_RECT,
+        CANVAS_FILL_CIRCLE,
+        CANVAS_DRAW_CIRCLE,
+        CANVAS_FILL_ELLIPSE,
+        CANVAS_DRAW_ELLIPSE,
+        CANVAS_DRAW_LINE,
+        CANVAS_FILL_TRIANGLE,
+        CANVAS_FILL_POLYGON,
+        CANVAS_DRAW_POLYGON,
+
+        // Exports
+        EXPORT_BMP,
+        EXPORT_SVG,
+        EXPORT_JSON,
+
+        // Undo/Redo
+        UNDO_SAVE_STATE,
+        UNDO,
+        REDO,
+
+        OPERATION_COUNT
+    };
+
+    /**
+     * @brief Summary of the samples recorded for one operation
+     * Percentiles come from a bounded uniform sample of the calls; count,
+     * total, min and max cover every call.
+     */
+    struct Stats {
+        uint64_t count = 0;
+        uint64_t totalNs = 0;
+        uint64_t minNs = 0;
+        uint64_t maxNs = 0;
+        uint64_t p50Ns = 0;
+        uint64_t p90Ns = 0;
+        uint64_t p99Ns = 0;
+    };
+
+    /**
+     * @brief Times the enclosing scope when profiling is enabled at construction
+     */
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(Operation op) : op(op), active(isEnabled()) {
+            if (active) start = std::chrono::steady_clock::now();
+        }
+
+        ~ScopedTimer() {
+            if (active) {
+                auto elapsed = std::chrono::steady_clock::now() - start;
+                record(op, static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+            }
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        Operation op;
+        bool active;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    /**
+     * @brief Turns recording on or off (already recorded data is kept)
+     */
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /**
+     * @brief Adds one call of the given duration
+     */
+    static void record(Operation op, uint64_t nanoseconds);
+
+    /**
+     * @brief Gets the summary for one operation
+     */
+    static Stats getStats(Operation op);
+
+    /**
+     * @brief Discards everything recorded so far
+     */
+    static void reset();
+
+    /**
+     * @brief Gets the printable name of an operation, e.g. "canvas.fillCircle"
+     */
+    static const char* getOperationName(Operation op);
+
+    /**
+     * @brief Formats a table of every operation that has been called
+     */
+    static std::string report();
+
+    /**
+     * @brief Writes the summary as CSV (one row per operation, times in ns)
+     * @return True if the file was written
+     */
+    static bool dumpToFile(const std::string& filename);
+};
+
+#ifdef SLIDESHOW_NO_PROFILING
+#define SLIDESHOW_PROFILE_SCOPE(op) ((void)0)
+#else
+/**
+ * @brief Times the rest of the enclosing scope as the given Profiler operation
+ */
+#define SLIDESHOW_PROFILE_SCOPE(op) Profiler::ScopedTimer profileScope(Profiler::op)
+#endif
+
+#endif // PROFILER_H
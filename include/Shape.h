@@ -6,8 +6,11 @@
 #include <vector>
 #include "Color.h"
 
-// Forward declaration
+// Forward declarations
 class Canvas;
+class JsonWriter;
+class SvgWriter;
+struct SvgStyle;
 
 /**
  * @brief Abstract base class for all shapes with visual properties
@@ -26,6 +29,15 @@ protected:
     double rotation;  // in degrees
     bool filled;
 
+    // Lazily built vertex list, invalidated whenever position or size changes
+    mutable std::vector<std::pair<int, int>> vertexCache;
+    mutable bool vertexCacheValid;
+
+    /**
+     * @brief Writes the members of the shape's JSON object; subclasses append their own
+     */
+    virtual void writeJSONMembers(JsonWriter& out) const;
+
 public:
     /**
      * @brief Constructs a Shape with all properties
@@ -52,14 +64,25 @@ public:
     bool isFilled() const { return filled; }
 
     // Setters
-    void setPosition(int newX, int newY) { x = newX; y = newY; }
-    void setSize(int w, int h) { width = w; height = h; }
+    void setPosition(int newX, int newY) { x = newX; y = newY; vertexCacheValid = false; }
+    void setSize(int w, int h) { width = w; height = h; vertexCacheValid = false; }
     void setFillColor(const Color& color) { fillColor = color; }
     void setBorderColor(const Color& color) { borderColor = color; }
     void setBorderWidth(int w) { borderWidth = w; }
     void setRotation(double r) { rotation = r; }
     void setFilled(bool f) { filled = f; }
 
+    /**
+     * @brief Moves the shape by an offset
+     */
+    virtual void translate(int dx, int dy);
+
+    /**
+     * @brief Scales the shape's position and size about a point
+     * Width and height never drop below one pixel.
+     */
+    virtual void scale(double factor, int originX, int originY);
+
     /**
      * @brief Displays shape info in text format
      */
@@ -75,15 +98,30 @@ public:
      */
     virtual void render(Canvas& canvas) const = 0;
 
+    /**
+     * @brief Writes the shape's SVG element (no indentation or newline)
+     */
+    virtual void writeSVG(SvgWriter& out) const = 0;
+
     /**
      * @brief Gets SVG representation of the shape
      */
-    virtual std::string toSVG() const = 0;
+    std::string toSVG() const;
+
+    /**
+     * @brief Gets the fill/stroke paint the SVG element is written with
+     */
+    virtual SvgStyle getSVGStyle() const;
+
+    /**
+     * @brief Writes the shape as a JSON object
+     */
+    void writeJSON(JsonWriter& out) const;
 
     /**
-     * @brief Gets JSON representation of the shape
+     * @brief Gets JSON representation of the shape (pretty-printed)
      */
-    virtual std::string toJSON() const;
+    std::string toJSON() const;
 
     /**
      * @brief Gets ASCII art representation (small icon)
@@ -96,6 +134,30 @@ public:
     virtual std::unique_ptr<Shape> clone() const = 0;
 };
 
+/**
+ * @brief Base class for shapes whose outline is a closed polygon
+ * Vertices are generated once by buildVertices() and cached on the shape,
+ * so the Canvas rasterizer and the SVG writer consume the same geometry.
+ */
+class PolygonShape : public Shape {
+public:
+    using Shape::Shape;
+
+    void render(Canvas& canvas) const override;
+    void writeSVG(SvgWriter& out) const override;
+
+    /**
+     * @brief Gets the cached polygon vertices, rebuilding them if stale
+     */
+    const std::vector<std::pair<int, int>>& getVertices() const;
+
+protected:
+    /**
+     * @brief Computes the polygon vertices from the current position and size
+     */
+    virtual void buildVertices(std::vector<std::pair<int, int>>& out) const = 0;
+};
+
 // ============== Concrete Shape Classes ==============
 
 class Circle : public Shape {
@@ -106,7 +168,7 @@ public:
            int borderWidth = 2, bool filled = true);
 
     void render(Canvas& canvas) const override;
-    std::string toSVG() const override;
+    void writeSVG(SvgWriter& out) const override;
     std::string getAsciiIcon() const override;
     std::unique_ptr<Shape> clone() const override;
 
@@ -121,7 +183,7 @@ public:
               int borderWidth = 2, bool filled = true);
 
     void render(Canvas& canvas) const override;
-    std::string toSVG() const override;
+    void writeSVG(SvgWriter& out) const override;
     std::string getAsciiIcon() const override;
     std::unique_ptr<Shape> clone() const override;
 };
@@ -137,7 +199,7 @@ public:
     std::unique_ptr<Shape> clone() const override;
 };
 
-class Triangle : public Shape {
+class Triangle : public PolygonShape {
 public:
     Triangle(int x, int y, int base = 40, int height = 30,
              const Color& fillColor = Color::Yellow(),
@@ -145,61 +207,67 @@ public:
              int borderWidth = 2, bool filled = true);
 
     void render(Canvas& canvas) const override;
-    std::string toSVG() const override;
     std::string getAsciiIcon() const override;
     std::unique_ptr<Shape> clone() const override;
+
+protected:
+    void buildVertices(std::vector<std::pair<int, int>>& out) const override;
 };
 
-class Diamond : public Shape {
+class Diamond : public PolygonShape {
 public:
     Diamond(int x, int y, int width = 30, int height = 40,
             const Color& fillColor = Color::Cyan(),
             const Color& borderColor = Color::White(),
             int borderWidth = 2, bool filled = true);
 
-    void render(Canvas& canvas) const override;
-    std::string toSVG() const override;
     std::string getAsciiIcon() const override;
     std::unique_ptr<Shape> clone() const override;
+
+protected:
+    void buildVertices(std::vector<std::pair<int, int>>& out) const override;
 };
 
-class Star : public Shape {
+class Star : public PolygonShape {
 public:
     Star(int x, int y, int size = 40,
          const Color& fillColor = Color::Gold(),
          const Color& borderColor = Color::Orange(),
          int borderWidth = 2, bool filled = true);
 
-    void render(Canvas& canvas) const override;
-    std::string toSVG() const override;
     std::string getAsciiIcon() const override;
     std::unique_ptr<Shape> clone() const override;
+
+protected:
+    void buildVertices(std::vector<std::pair<int, int>>& out) const override;
 };
 
-class Hexagon : public Shape {
+class Hexagon : public PolygonShape {
 public:
     Hexagon(int x, int y, int size = 35,
             const Color& fillColor = Color::Purple(),
             const Color& borderColor = Color::White(),
             int borderWidth = 2, bool filled = true);
 
-    void render(Canvas& canvas) const override;
-    std::string toSVG() const override;
     std::string getAsciiIcon() const override;
     std::unique_ptr<Shape> clone() const override;
+
+protected:
+    void buildVertices(std::vector<std::pair<int, int>>& out) const override;
 };
 
-class Pentagon : public Shape {
+class Pentagon : public PolygonShape {
 public:
     Pentagon(int x, int y, int size = 35,
              const Color& fillColor = Color::Teal(),
              const Color& borderColor = Color::White(),
              int borderWidth = 2, bool filled = true);
 
-    void render(Canvas& canvas) const override;
-    std::string toSVG() const override;
     std::string getAsciiIcon() const override;
     std::unique_ptr<Shape> clone() const override;
+
+protected:
+    void buildVertices(std::vector<std::pair<int, int>>& out) const override;
 };
 
 class Oval : public Shape {
@@ -210,35 +278,37 @@ public:
          int borderWidth = 2, bool filled = true);
 
     void render(Canvas& canvas) const override;
-    std::string toSVG() const override;
+    void writeSVG(SvgWriter& out) const override;
     std::string getAsciiIcon() const override;
     std::unique_ptr<Shape> clone() const override;
 };
 
-class Trapezoid : public Shape {
+class Trapezoid : public PolygonShape {
 public:
     Trapezoid(int x, int y, int width = 50, int height = 30,
               const Color& fillColor = Color::Coral(),
               const Color& borderColor = Color::White(),
               int borderWidth = 2, bool filled = true);
 
-    void render(Canvas& canvas) const override;
-    std::string toSVG() const override;
     std::string getAsciiIcon() const override;
     std::unique_ptr<Shape> clone() const override;
+
+protected:
+    void buildVertices(std::vector<std::pair<int, int>>& out) const override;
 };
 
-class Rhombus : public Shape {
+class Rhombus : public PolygonShape {
 public:
     Rhombus(int x, int y, int width = 40, int height = 50,
             const Color& fillColor = Color::Violet(),
             const Color& borderColor = Color::White(),
             int borderWidth = 2, bool filled = true);
 
-    void render(Canvas& canvas) const override;
-    std::string toSVG() const override;
     std::string getAsciiIcon() const override;
     std::unique_ptr<Shape> clone() const override;
+
+protected:
+    void buildVertices(std::vector<std::pair<int, int>>& out) const override;
 };
 
 class Line : public Shape {
@@ -250,12 +320,19 @@ public:
          int lineWidth = 2);
 
     void render(Canvas& canvas) const override;
-    std::string toSVG() const override;
+    void writeSVG(SvgWriter& out) const override;
+    SvgStyle getSVGStyle() const override;
     std::string getAsciiIcon() const override;
     std::unique_ptr<Shape> clone() const override;
 
     int getX2() const { return x2; }
     int getY2() const { return y2; }
+
+    void translate(int dx, int dy) override;
+    void scale(double factor, int originX, int originY) override;
+
+protected:
+    void writeJSONMembers(JsonWriter& out) const override;
 };
 
 class Text : public Shape {
@@ -268,12 +345,18 @@ public:
          int fontSize = 16);
 
     void render(Canvas& canvas) const override;
-    std::string toSVG() const override;
+    void writeSVG(SvgWriter& out) const override;
+    SvgStyle getSVGStyle() const override;
     std::string getAsciiIcon() const override;
     std::unique_ptr<Shape> clone() const override;
 
     std::string getContent() const { return content; }
     void setContent(const std::string& text) { content = text; }
+
+    void scale(double factor, int originX, int originY) override;
+
+protected:
+    void writeJSONMembers(JsonWriter& out) const override;
 };
 
 #endif // SHAPE_H
@@ -28,6 +28,7 @@ public:
         int borderWidth = 2;
         bool filled = true;
         std::string text = "";  // For Text shapes
+        int fontSize = 16;      // For Text shapes
         int x2 = 0, y2 = 0;     // For Line shapes
     };
 
@@ -4,6 +4,9 @@
 #include "Shape.h"
 #include "Canvas.h"
 #include "Color.h"
+#include "JsonWriter.h"
+#include "SvgWriter.h"
+#include <functional>
 #include <vector>
 #include <memory>
 #include <string>
@@ -35,6 +38,12 @@ public:
      */
     Slide& operator=(const Slide& other);
 
+    /**
+     * @brief Move constructor and assignment take over the shapes without cloning
+     */
+    Slide(Slide&& other) = default;
+    Slide& operator=(Slide&& other) = default;
+
     /**
      * @brief Adds a shape to the slide
      * @param shape Shared pointer to the shape to add
@@ -47,6 +56,51 @@ public:
      */
     bool removeShape(size_t index);
 
+    // Bulk operations: each call changes the shape list in a single pass. Selections are
+    // 0-based indices in any order; duplicates and out-of-range indices are
+    // ignored, and selected shapes are visited in slide order.
+
+    /**
+     * @brief Appends several shapes, growing the list once
+     */
+    void addShapes(const std::vector<std::shared_ptr<Shape>>& newShapes);
+
+    /**
+     * @brief Removes the selected shapes, keeping the order of the rest
+     * @return Number of shapes removed
+     */
+    size_t removeShapes(const std::vector<size_t>& indices);
+
+    /**
+     * @brief Removes every shape the predicate accepts
+     * @return Number of shapes removed
+     */
+    size_t removeShapesIf(const std::function<bool(const Shape&)>& predicate);
+
+    /**
+     * @brief Calls transform on each selected shape
+     * @return Number of shapes transformed
+     */
+    size_t transformShapes(const std::vector<size_t>& indices, const std::function<void(Shape&)>& transform);
+
+    /**
+     * @brief Moves the selected shapes by an offset
+     */
+    size_t translateShapes(const std::vector<size_t>& indices, int dx, int dy);
+
+    /**
+     * @brief Scales the selected shapes about the top-left corner of their bounding box
+     * Scaled coordinates and sizes are clamped to +/-65536.
+     * @return Number of shapes scaled; 0 if the factor is not positive and finite
+     */
+    size_t scaleShapes(const std::vector<size_t>& indices, double factor);
+
+    /**
+     * @brief Sets the fill color of the selected shapes, and optionally their border color
+     */
+    size_t recolorShapes(const std::vector<size_t>& indices, const Color& fillColor);
+    size_t recolorShapes(const std::vector<size_t>& indices, const Color& fillColor, const Color& borderColor);
+
     /**
      * @brief Gets a shape by index
      */
@@ -64,8 +118,9 @@ public:
 
     /**
      * @brief Renders the slide to a canvas
+     * @param antiAliased Blend shape edges by coverage (slower, for image export)
      */
-    Canvas render() const;
+    Canvas render(bool antiAliased = false) const;
 
     /**
      * @brief Displays the slide as ASCII art in terminal
@@ -74,31 +129,67 @@ public:
 
     /**
      * @brief Exports the slide to a BMP image file
+     * @param antiAliased Render with anti-aliased edges
      * @return True if successful
      */
-    bool exportBMP(const std::string& filename) const;
+    bool exportBMP(const std::string& filename, bool antiAliased = true) const;
 
     /**
      * @brief Exports the slide to an SVG file
+     * @param optimized Share repeated styles and polygon geometry (see SvgWriter)
+     * @return True if successful
+     */
+    bool exportSVG(const std::string& filename, bool optimized = false) const;
+
+    /**
+     * @brief Exports the slide to an SVG file through a caller-owned writer
+     * Reusing one writer across slides reuses its buffer; the writer's
+     * optimized setting selects the output mode.
      * @return True if successful
      */
-    bool exportSVG(const std::string& filename) const;
+    bool exportSVG(const std::string& filename, SvgWriter& writer) const;
 
     /**
      * @brief Exports the slide to a JSON file
+     * @param pretty Indent the output; false writes compact JSON
      * @return True if successful
      */
-    bool exportJSON(const std::string& filename) const;
+    bool exportJSON(const std::string& filename, bool pretty = true) const;
+
+    /**
+     * @brief Exports the slide to a JSON file through a caller-owned writer
+     * The writer's pretty setting selects the output layout.
+     * @return True if successful
+     */
+    bool exportJSON(const std::string& filename, JsonWriter& writer) const;
+
+    /**
+     * @brief Streams the SVG document into a writer
+     * In optimized mode, repeated paints become CSS classes, repeated polygon
+     * outlines become <defs>/<use> and shapes are not indented.
+     */
+    void writeSVG(SvgWriter& out) const;
 
     /**
      * @brief Gets SVG content as a string
      */
-    std::string toSVG() const;
+    std::string toSVG(bool optimized = false) const;
+
+    /**
+     * @brief Counts the bytes of the SVG document without keeping the text
+     * The writer's optimized setting selects the form that is measured.
+     */
+    uint64_t measureSVG(SvgWriter& writer) const;
+
+    /**
+     * @brief Streams the slide as a JSON object into a writer
+     */
+    void writeJSON(JsonWriter& out) const;
 
     /**
      * @brief Gets JSON content as a string
      */
-    std::string toJSON() const;
+    std::string toJSON(bool pretty = true) const;
 
     /**
      * @brief Checks if the slide is empty
@@ -127,6 +218,12 @@ public:
      * @brief Converts slide to file format string for saving
      */
     std::string toFileFormat() const;
+
+private:
+    /**
+     * @brief Flags the shapes a selection covers, one entry per shape
+     */
+    std::vector<bool> selectionMask(const std::vector<size_t>& indices) const;
 };
 
 #endif // SLIDE_H
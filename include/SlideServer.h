@@ -0,0 +1,130 @@
+#ifndef SLIDESERVER_H
+#define SLIDESERVER_H
+
+#include "SlideShow.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Long-running server that executes slideshow requests from local clients
+ *
+ * Clients connect to a Unix domain socket and exchange frames: a 4-byte
+ * big-endian payload length followed by that many bytes. A request payload is
+ * one command line, e.g. "load deck.txt" or "render deck.txt 2 svg". The
+ * response payload starts with "OK" or "ERR <message>"; any body follows the
+ * first newline. Loaded presentations and rendered slides stay cached across
+ * requests and clients, and each client is served on its own thread.
+ */
+class SlideServer {
+public:
+    /**
+     * @brief Largest request or response payload accepted, in bytes
+     * A response that would be larger is sent as "ERR response too large".
+     */
+    static constexpr uint32_t kMaxFrameSize = 16 * 1024 * 1024;
+
+    SlideServer();
+    ~SlideServer();
+
+    SlideServer(const SlideServer&) = delete;
+    SlideServer& operator=(const SlideServer&) = delete;
+
+    /**
+     * @brief Checks whether this platform supports server mode
+     */
+    static bool isSupported();
+
+    /**
+     * @brief Creates and listens on the socket
+     * A stale socket file at the path is replaced; any other file is left alone.
+     * @return True if the server is ready to accept clients
+     */
+    bool start(const std::string& socketPath);
+
+    /**
+     * @brief Accepts and serves clients until stop() or a "shutdown" request
+     */
+    void run();
+
+    /**
+     * @brief Asks run() to disconnect all clients and return (thread safe)
+     */
+    void stop();
+
+    /**
+     * @brief Executes one request and returns the response payload (thread safe)
+     * Lets a host process drive the server without going through the socket.
+     */
+    std::string handleRequest(const std::string& request);
+
+    // Statistics
+    uint64_t getRequestCount() const { return requestCount.load(); }
+    uint64_t getRenderCacheHits() const { return renderCacheHits.load(); }
+
+private:
+    /**
+     * @brief A loaded presentation plus the slides rendered from it
+     * The mutex guards both; edits clear the render cache.
+     */
+    struct Deck {
+        std::mutex mutex;
+        std::unique_ptr<SlideShow> slideshow;
+        std::map<std::string, std::string> renderCache;
+    };
+
+    using Handler = std::string (SlideServer::*)(const std::vector<std::string>& args);
+
+    struct RequestSpec {
+        const char* name;
+        size_t minArgs;
+        Handler handler;
+        const char* usage;
+    };
+
+    static const RequestSpec kRequests[];
+
+    std::string socketPath;
+    int listenFd;
+    std::atomic<bool> stopping;
+
+    std::mutex decksMutex;
+    std::map<std::string, std::shared_ptr<Deck>> decks;
+
+    // Connected clients; run() waits for the set to empty before returning
+    std::mutex clientsMutex;
+    std::condition_variable clientsDone;
+    std::set<int> clientFds;
+
+    std::atomic<uint64_t> requestCount;
+    std::atomic<uint64_t> renderCacheHits;
+
+    void serveClient(int fd);
+    std::shared_ptr<Deck> findDeck(const std::string& filename);
+
+    // Request handlers; args[0] is the request name
+    std::string handlePing(const std::vector<std::string>& args);
+    std::string handleLoad(const std::vector<std::string>& args);
+    std::string handleReload(const std::vector<std::string>& args);
+    std::string handleClose(const std::vector<std::string>& args);
+    std::string handleList(const std::vector<std::string>& args);
+    std::string handleInfo(const std::vector<std::string>& args);
+    std::string handleAdd(const std::vector<std::string>& args);
+    std::string handleDelete(const std::vector<std::string>& args);
+    std::string handleMove(const std::vector<std::string>& args);
+    std::string handleResize(const std::vector<std::string>& args);
+    std::string handleFill(const std::vector<std::string>& args);
+    std::string handleRender(const std::vector<std::string>& args);
+    std::string handleExport(const std::vector<std::string>& args);
+    std::string handleSave(const std::vector<std::string>& args);
+    std::string handleStats(const std::vector<std::string>& args);
+    std::string handleShutdown(const std::vector<std::string>& args);
+};
+
+#endif // SLIDESERVER_H
@@ -2,31 +2,86 @@
 #define SLIDESHOW_H
 
 #include "Slide.h"
+#include <cstdint>
+#include <filesystem>
 #include <vector>
 #include <string>
+#include <memory>
+
+class EditJournal;
+class TerminalRenderer;
 
 /**
  * @brief Manages a collection of slides for a single presentation file
  */
 class SlideShow {
 private:
+    /**
+     * @brief Where a slide's text lies in the deck file, so save() can copy it instead of reformatting
+     */
+    struct SlideSource {
+        uint64_t offset = 0;
+        uint64_t length = 0;
+        bool clean = false;  // Unchanged since it was read from or written to this range
+    };
+
     std::vector<Slide> slides;
     int currentSlideIndex;
     std::string filename;
     bool modified;
 
+    // One source range per slide, in the text file at sourcePath. The file's
+    // size and time are recorded so a deck changed on disk is not copied from.
+    std::vector<SlideSource> sources;
+    std::string sourcePath;
+    uintmax_t sourceSize;
+    std::filesystem::file_time_type sourceTime;
+    bool crlf;  // The text file ends lines with CRLF; saves write new lines the same way
+
+    void setSourceFile(const std::string& path);
+    bool isSourceUnchanged() const;
+    bool writeTextFile(const std::string& path, std::vector<SlideSource>& written) const;
+
+    // Records edits for crash recovery once enableJournal() has been called
+    std::unique_ptr<EditJournal> journal;
+
+    void journalSlide(int slideNumber);
+
 public:
     /**
      * @brief Constructs a SlideShow with a filename
      * @param filename The name of the presentation file
      */
     SlideShow(const std::string& filename);
+    ~SlideShow();
+    SlideShow(SlideShow&&) noexcept;
+    SlideShow& operator=(SlideShow&&) noexcept;
+
+    /**
+     * @brief Loads a presentation file, one slide per "---" separated block
+     * @param filename The presentation file to read
+     * @return The loaded slideshow, or nullptr if the file cannot be opened
+     */
+    static std::unique_ptr<SlideShow> load(const std::string& filename);
+
+    /**
+     * @brief Loads a presentation from JSON written by exportSlideshowJSON() or Slide::exportJSON()
+     * The file is parsed in a single pass, building shapes through ShapeFactory.
+     * @return The loaded slideshow, or nullptr if the file cannot be opened or is not valid JSON
+     */
+    static std::unique_ptr<SlideShow> loadJSON(const std::string& filename);
+
+    /**
+     * @brief Checks whether a filename ends in ".json" (any case)
+     */
+    static bool isJSONFile(const std::string& filename);
 
     /**
      * @brief Adds a slide to the slideshow
      * @param slide The slide to add
      */
     void addSlide(const Slide& slide);
+    void addSlide(Slide&& slide);
 
     /**
      * @brief Creates and adds a new empty slide
@@ -67,6 +122,12 @@ public:
      */
     void showVisual() const;
 
+    /**
+     * @brief Displays the current slide through a pinned, diff-based preview
+     * Only cells that changed since the renderer's last frame are redrawn.
+     */
+    void showVisual(TerminalRenderer& renderer) const;
+
     /**
      * @brief Jumps to a specific slide (1-based index)
      * @param slideNumber The slide number to jump to
@@ -104,41 +165,65 @@ public:
      */
     const Slide* getCurrentSlide() const;
 
+    /**
+     * @brief Gets a slide by number (1-based) without changing the current slide
+     * @return The slide, or nullptr if the number is out of range
+     */
+    Slide* getSlide(int slideNumber);
+    const Slide* getSlide(int slideNumber) const;
+
     /**
      * @brief Exports current slide to BMP
+     * @param antiAliased Render with anti-aliased edges
      */
-    bool exportCurrentSlideBMP(const std::string& filename) const;
+    bool exportCurrentSlideBMP(const std::string& filename, bool antiAliased = true) const;
 
     /**
      * @brief Exports current slide to SVG
+     * @param optimized Share repeated styles and polygon geometry
+     */
+    bool exportCurrentSlideSVG(const std::string& filename, bool optimized = false) const;
+
+    /**
+     * @brief Exports current slide to SVG through a caller-owned writer
+     * The writer's optimized setting selects the output mode, and its
+     * getBytesWritten() gives the file size afterwards.
      */
-    bool exportCurrentSlideSVG(const std::string& filename) const;
+    bool exportCurrentSlideSVG(const std::string& filename, SvgWriter& writer) const;
 
     /**
      * @brief Exports current slide to JSON
+     * @param pretty Indent the output; false writes compact JSON
      */
-    bool exportCurrentSlideJSON(const std::string& filename) const;
+    bool exportCurrentSlideJSON(const std::string& filename, bool pretty = true) const;
 
     /**
      * @brief Exports all slides to BMP files
      * @param prefix Filename prefix (e.g., "slide" creates slide_1.bmp, slide_2.bmp, etc.)
+     * @param antiAliased Render with anti-aliased edges
      */
-    void exportAllSlidesBMP(const std::string& prefix) const;
+    void exportAllSlidesBMP(const std::string& prefix, bool antiAliased = true) const;
 
     /**
      * @brief Exports all slides to SVG files
+     * @param optimized Share repeated styles and polygon geometry, and report
+     *        each file's size against plain SVG
      */
-    void exportAllSlidesSVG(const std::string& prefix) const;
+    void exportAllSlidesSVG(const std::string& prefix, bool optimized = false) const;
 
     /**
      * @brief Exports all slides to JSON files
+     * @param pretty Indent the output; false writes compact JSON
      */
-    void exportAllSlidesJSON(const std::string& prefix) const;
+    void exportAllSlidesJSON(const std::string& prefix, bool pretty = true) const;
 
     /**
      * @brief Exports entire slideshow to a single JSON file
+     * Slides are streamed into the file one after another, so the deck is
+     * never held in memory as a string.
+     * @param pretty Indent the output; false writes compact JSON
      */
-    bool exportSlideshowJSON(const std::string& filename) const;
+    bool exportSlideshowJSON(const std::string& filename, bool pretty = true) const;
 
     /**
      * @brief Checks if slideshow has been modified
@@ -147,11 +232,51 @@ public:
 
     /**
      * @brief Marks slideshow as modified
+     * Marking it modified treats every slide as changed; prefer markSlideModified().
+     */
+    void setModified(bool m);
+
+    /**
+     * @brief Marks one slide (1-based) as changed, so the next save() reformats it
+     */
+    void markSlideModified(int slideNumber);
+
+    /**
+     * @brief Gets the number of slides the next save() reformats rather than copies
+     */
+    int getDirtySlideCount() const;
+
+    /**
+     * @brief Records every later edit in "<file>.journal" (see EditJournal)
+     * A journal left next to the file by a session that ended without saving
+     * is replayed first, restoring its unsaved edits.
+     * @return Number of edits recovered, or -1 if the journal was stale and ignored
+     */
+    int enableJournal();
+
+    /**
+     * @brief Waits until every journaled edit is on disk
+     * @return False if writing the journal failed
+     */
+    bool syncJournal();
+
+    /**
+     * @brief Stops journaling and deletes the journal, e.g. when the session ends normally
+     */
+    void discardJournal();
+
+    /**
+     * @brief Gets the journal's path, or an empty string when edits are not journaled
      */
-    void setModified(bool m) { modified = m; }
+    std::string getJournalPath() const;
 
     /**
      * @brief Saves the slideshow to a file
+     * Slides that have not changed since the deck was loaded or last saved
+     * are copied byte for byte from that file; only the rest are formatted.
+     * The file is written to "<name>.tmp" and then renamed over the target,
+     * so a failed save leaves the previous file intact. The edit journal is
+     * deleted once the new file is in place.
      * @param filename Optional new filename (uses current if empty)
      * @return True if saved successfully
      */
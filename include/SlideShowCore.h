@@ -0,0 +1,29 @@
+#ifndef SLIDESHOWCORE_H
+#define SLIDESHOWCORE_H
+
+/**
+ * @brief Public API of the slideshow_core library
+ * Including this header is enough to load, edit, render and export
+ * presentations in-process, without going through the CLI.
+ */
+
+#include "Color.h"
+#include "Canvas.h"
+#include "PixelKernels.h"
+#include "Profiler.h"
+#include "Tracer.h"
+#include "BufferedWriter.h"
+#include "SvgWriter.h"
+#include "Shape.h"
+#include "ShapeFactory.h"
+#include "Slide.h"
+#include "SlideShow.h"
+#include "EditJournal.h"
+#include "FileSync.h"
+#include "UndoManager.h"
+#include "Tokenizer.h"
+#include "CommandParser.h"
+#include "TerminalRenderer.h"
+#include "SlideServer.h"
+
+#endif // SLIDESHOWCORE_H
@@ -0,0 +1,72 @@
+#ifndef TERMINALRENDERER_H
+#define TERMINALRENDERER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Canvas.h"
+#include "Color.h"
+
+/**
+ * @brief Keeps the ASCII preview pinned at the top of the terminal and
+ * redraws only what changed between frames
+ * The first frame clears the screen, draws the whole preview and restricts
+ * scrolling to the lines below it. Later frames move the cursor to each run
+ * of changed cells and rewrite just those, emitting a color escape only when
+ * the color actually changes.
+ */
+class TerminalRenderer {
+private:
+    struct Cell {
+        bool filled;
+        Color color;
+
+        bool operator==(const Cell& other) const {
+            return filled == other.filled && (!filled || color == other.color);
+        }
+    };
+
+    std::vector<Cell> cells;
+    int columns;
+    int rows;
+    std::string header;
+    bool active;
+
+    size_t lastFrameBytes;
+    int lastChangedCells;
+    size_t totalBytes;
+    int frameCount;
+
+public:
+    TerminalRenderer();
+
+    /**
+     * @brief Shows a canvas with a one-line header above it
+     * @return Bytes written to the terminal for this frame
+     */
+    size_t present(const Canvas& canvas, const std::string& headerText);
+
+    /**
+     * @brief Gives the whole screen back to normal scrolling output
+     * The next present() redraws the full frame.
+     */
+    void release();
+
+    bool isActive() const { return active; }
+    size_t getLastFrameBytes() const { return lastFrameBytes; }
+    int getLastChangedCells() const { return lastChangedCells; }
+    size_t getTotalBytes() const { return totalBytes; }
+    int getFrameCount() const { return frameCount; }
+
+    /**
+     * @brief Checks whether stdout is a terminal that can take cursor codes
+     */
+    static bool isInteractive();
+
+private:
+    void sampleCells(const Canvas& canvas, std::vector<Cell>& out) const;
+    void writeFullFrame(const std::vector<Cell>& next, std::string& out) const;
+    int writeChangedCells(const std::vector<Cell>& next, const std::string& headerText, std::string& out) const;
+};
+
+#endif // TERMINALRENDERER_H
@@ -0,0 +1,78 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Records timed spans and writes them as Chrome trace-event JSON
+ * Open the output in chrome://tracing or https://ui.perfetto.dev to see
+ * each thread's spans on a timeline. Recording is off until start(); an
+ * inactive span costs one relaxed atomic load. At most a million spans are
+ * kept per trace. Safe to use from several threads.
+ */
+class Tracer {
+public:
+    /**
+     * @brief One complete ("X") event covering the lifetime of the object
+     * Arguments show up in the trace viewer's detail pane.
+     */
+    class Span {
+    public:
+        /**
+         * @param category Filter group in the viewer, e.g. "render", "export" or "io"
+         * @param name Span label; both strings must outlive the trace (use literals)
+         */
+        Span(const char* category, const char* name);
+        ~Span();
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+        bool isActive() const { return active; }
+
+        /**
+         * @brief Attaches an argument (ignored while tracing is off)
+         */
+        void arg(const char* key, int64_t value);
+        void arg(const char* key, const std::string& value);
+
+    private:
+        const char* category;
+        const char* name;
+        bool active;
+        std::chrono::steady_clock::time_point start;
+        std::string args;  // JSON members without the braces
+    };
+
+    /**
+     * @brief Discards earlier events and starts recording
+     */
+    static void start();
+
+    /**
+     * @brief Stops recording (events are kept until the next start)
+     */
+    static void stop();
+
+    static bool isEnabled();
+
+    /**
+     * @brief Names the calling thread's track in the trace viewer
+     */
+    static void setThreadName(const std::string& name);
+
+    /**
+     * @brief Gets the number of events recorded since start()
+     */
+    static size_t getEventCount();
+
+    /**
+     * @brief Writes every recorded event as a Chrome trace JSON file
+     * @return True if the file was written
+     */
+    static bool writeToFile(const std::string& filename);
+};
+
+#endif // TRACER_H
@@ -0,0 +1,86 @@
+#include "BufferedWriter.h"
+#include "Tracer.h"
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+
+BufferedWriter::BufferedWriter(size_t capacity)
+    : capacity(capacity > 0 ? capacity : kDefaultCapacity), bytesFlushed(0), counting(false) {
+    buffer.reserve(this->capacity + 256);
+}
+
+BufferedWriter::~BufferedWriter() {
+    close();
+}
+
+bool BufferedWriter::open(const std::string& filename) {
+    close();
+    buffer.clear();
+    bytesFlushed = 0;
+    counting = false;
+    file.open(filename, std::ios::binary);
+    return file.is_open();
+}
+
+bool BufferedWriter::close() {
+    if (!file.is_open()) {
+        return true;
+    }
+    flush();
+    file.close();
+    bool ok = !file.fail();
+    file.clear();
+    return ok;
+}
+
+void BufferedWriter::startCounting() {
+    close();
+    buffer.clear();
+    bytesFlushed = 0;
+    counting = true;
+}
+
+std::string BufferedWriter::takeString() {
+    std::string text;
+    text.reserve(buffer.capacity());
+    text.swap(buffer);
+    bytesFlushed = 0;
+    counting = false;
+    return text;
+}
+
+void BufferedWriter::flush() {
+    if (counting) {
+        bytesFlushed += buffer.size();
+        buffer.clear();
+        return;
+    }
+    if (!file.is_open() || buffer.empty()) {
+        return;
+    }
+    Tracer::Span span("io", "file write");
+    span.arg("bytes", static_cast<int64_t>(buffer.size()));
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    bytesFlushed += buffer.size();
+    buffer.clear();
+}
+
+void BufferedWriter::writeInt(int64_t value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    write(digits, static_cast<size_t>(result.ptr - digits));
+}
+
+void BufferedWriter::writeDouble(double value) {
+    // Whole numbers below 1e6 print the same under %g as integers do (except -0)
+    if (value > -1e6 && value < 1e6 && value == static_cast<double>(static_cast<int64_t>(value)) &&
+        !(value == 0.0 && std::signbit(value))) {
+        writeInt(static_cast<int64_t>(value));
+        return;
+    }
+    char digits[32];
+    int length = std::snprintf(digits, sizeof(digits), "%g", value);
+    if (length > 0) {
+        write(digits, static_cast<size_t>(length));
+    }
+}
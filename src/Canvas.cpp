@@ -1,124 +1,457 @@
 #include "Canvas.h"
+#include "PixelKernels.h"
+#include "Profiler.h"
+#include "Tracer.h"
 #include <iostream>
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
 
-Canvas::Canvas(int width, int height, const Color& bgColor)
-    : width(width), height(height), backgroundColor(bgColor) {
-    pixels.resize(height, std::vector<Color>(width, bgColor));
+namespace {
+
+/**
+ * @brief Collects horizontal spans per row so overlapping stroke pieces
+ * (segment bodies and joins) can be merged and each pixel written once
+ */
+class SpanBuffer {
+private:
+    int minY;
+    std::vector<std::vector<std::pair<int, int>>> rows;
+
+public:
+    SpanBuffer(int minY, int maxY)
+        : minY(minY), rows(maxY >= minY ? maxY - minY + 1 : 0) {}
+
+    void add(int y, int x1, int x2) {
+        int row = y - minY;
+        if (row < 0 || row >= static_cast<int>(rows.size()) || x1 > x2) return;
+        rows[row].push_back({x1, x2});
+    }
+
+    /**
+     * @brief Calls emit(y, x1, x2) once per merged run, rows top to bottom
+     */
+    template <typename Emit>
+    void forEachMerged(Emit emit) {
+        for (size_t i = 0; i < rows.size(); ++i) {
+            auto& spans = rows[i];
+            if (spans.empty()) continue;
+            std::sort(spans.begin(), spans.end());
+            int y = minY + static_cast<int>(i);
+            int start = spans[0].first;
+            int end = spans[0].second;
+            for (size_t j = 1; j < spans.size(); ++j) {
+                if (spans[j].first <= end + 1) {
+                    end = std::max(end, spans[j].second);
+                } else {
+                    emit(y, start, end);
+                    start = spans[j].first;
+                    end = spans[j].second;
+                }
+            }
+            emit(y, start, end);
+        }
+    }
+};
+
+// Samples per pixel along each axis in anti-aliased mode (16 coverage levels)
+constexpr int kAASamples = 4;
+
+/**
+ * @brief Maps a pixel coordinate into sample space
+ * Sample i of a pixel sits at its center offset by (i + 0.5) / scale - 0.5,
+ * so for scale 1 this is the identity and samples are the integer points.
+ */
+inline double toSample(double v, int scale) {
+    return (v + 0.5) * scale - 0.5;
+}
+
+/**
+ * @brief Adds the rectangle of half width hw around segment (x1,y1)-(x2,y2)
+ * Samples are the integer points of the buffer's space; ends are left butt
+ * so joins and caps can be added separately.
+ */
+void addSegmentSpans(SpanBuffer& buffer, double x1, double y1, double x2, double y2, double hw) {
+    double dx = x2 - x1;
+    double dy = y2 - y1;
+    double len = std::sqrt(dx * dx + dy * dy);
+    if (len == 0.0) return;
     
-    // ASCII buffer is scaled down (each ASCII char represents multiple pixels)
-    int asciiWidth = width / 2;
-    int asciiHeight = height / 4;
-    asciiBuffer.resize(asciiHeight, std::vector<char>(asciiWidth, ' '));
-    asciiFgColors.resize(asciiHeight, std::vector<Color>(asciiWidth, bgColor));
+    double nx = -dy / len * hw;
+    double ny = dx / len * hw;
+    double quad[4][2] = {
+        {x1 + nx, y1 + ny}, {x2 + nx, y2 + ny},
+        {x2 - nx, y2 - ny}, {x1 - nx, y1 - ny}
+    };
+    
+    double top = quad[0][1], bottom = quad[0][1];
+    for (const auto& p : quad) {
+        top = std::min(top, p[1]);
+        bottom = std::max(bottom, p[1]);
+    }
+    
+    const double eps = 1e-9;
+    for (int y = static_cast<int>(std::ceil(top - eps)); y <= static_cast<int>(std::floor(bottom + eps)); ++y) {
+        // The quad is convex, so each row is a single run between the
+        // leftmost and rightmost edge crossings
+        double left = 1e18, right = -1e18;
+        for (int i = 0; i < 4; ++i) {
+            const double* a = quad[i];
+            const double* b = quad[(i + 1) % 4];
+            double ya = std::min(a[1], b[1]), yb = std::max(a[1], b[1]);
+            if (y < ya - eps || y > yb + eps) continue;
+            if (yb - ya < eps) {
+                left = std::min(left, std::min(a[0], b[0]));
+                right = std::max(right, std::max(a[0], b[0]));
+            } else {
+                double t = std::min(1.0, std::max(0.0, (y - a[1]) / (b[1] - a[1])));
+                double x = a[0] + t * (b[0] - a[0]);
+                left = std::min(left, x);
+                right = std::max(right, x);
+            }
+        }
+        if (left <= right) {
+            buffer.add(y, static_cast<int>(std::ceil(left - eps)), static_cast<int>(std::floor(right + eps)));
+        }
+    }
 }
 
-void Canvas::clear() {
-    for (auto& row : pixels) {
-        std::fill(row.begin(), row.end(), backgroundColor);
+/**
+ * @brief Adds the integer points inside an elliptical ring
+ * Pass inner radii <= 0 for a solid ellipse; a disc has rx == ry.
+ */
+void addEllipseSpans(SpanBuffer& buffer, double cx, double cy, double rx, double ry,
+                     double irx = 0.0, double iry = 0.0) {
+    if (rx <= 0.0 || ry <= 0.0) return;
+    const double eps = 1e-9;
+    bool hollow = irx > 0.0 && iry > 0.0;
+    for (int y = static_cast<int>(std::ceil(cy - ry - eps)); y <= static_cast<int>(std::floor(cy + ry + eps)); ++y) {
+        double dy = y - cy;
+        double outer = rx * std::sqrt(std::max(0.0, 1.0 - (dy * dy) / (ry * ry)));
+        int left = static_cast<int>(std::ceil(cx - outer - eps));
+        int right = static_cast<int>(std::floor(cx + outer + eps));
+        if (hollow && std::abs(dy) < iry) {
+            double inner = irx * std::sqrt(1.0 - (dy * dy) / (iry * iry));
+            buffer.add(y, left, static_cast<int>(std::ceil(cx - inner)) - 1);
+            buffer.add(y, static_cast<int>(std::floor(cx + inner)) + 1, right);
+        } else {
+            buffer.add(y, left, right);
+        }
     }
-    for (auto& row : asciiBuffer) {
-        std::fill(row.begin(), row.end(), ' ');
+}
+
+/**
+ * @brief Adds the integer points inside a polygon (even-odd rule)
+ */
+void addPolygonSpans(SpanBuffer& buffer, const std::vector<std::pair<double, double>>& points) {
+    if (points.size() < 3) return;
+    double top = points[0].second, bottom = points[0].second;
+    for (const auto& p : points) {
+        top = std::min(top, p.second);
+        bottom = std::max(bottom, p.second);
     }
-    for (auto& row : asciiFgColors) {
-        std::fill(row.begin(), row.end(), backgroundColor);
+    
+    std::vector<double> crossings;
+    size_t n = points.size();
+    for (int y = static_cast<int>(std::ceil(top)); y <= static_cast<int>(std::floor(bottom)); ++y) {
+        crossings.clear();
+        for (size_t i = 0, j = n - 1; i < n; j = i++) {
+            double yi = points[i].second, yj = points[j].second;
+            if ((yi > y) != (yj > y)) {
+                double xi = points[i].first, xj = points[j].first;
+                crossings.push_back(xi + (y - yi) * (xj - xi) / (yj - yi));
+            }
+        }
+        std::sort(crossings.begin(), crossings.end());
+        for (size_t k = 0; k + 1 < crossings.size(); k += 2) {
+            buffer.add(y, static_cast<int>(std::ceil(crossings[k])),
+                       static_cast<int>(std::floor(crossings[k + 1])));
+        }
     }
 }
 
+/**
+ * @brief Writes merged spans to the canvas
+ * With scale 1 the spans are pixels and are filled directly. Otherwise each
+ * span is in sample space: samples are counted per pixel and the color is
+ * blended with alpha = covered samples / total samples.
+ */
+void paintSpans(Canvas& canvas, SpanBuffer& buffer, int scale, const Color& color) {
+    if (scale == 1) {
+        buffer.forEachMerged([&](int y, int x1, int x2) {
+            canvas.fillSpan(y, x1, x2, color);
+        });
+        return;
+    }
+    
+    int width = canvas.getWidth();
+    int maxSample = width * scale - 1;
+    int samplesPerPixel = scale * scale;
+    std::vector<uint8_t> coverage(width, 0);
+    int currentRow = -1;
+    int minX = width, maxX = -1;
+    
+    auto flushRow = [&]() {
+        for (int x = minX; x <= maxX; ++x) {
+            coverage[x] = static_cast<uint8_t>((coverage[x] * color.a + samplesPerPixel / 2) / samplesPerPixel);
+        }
+        if (minX <= maxX) {
+            canvas.blendSpan(currentRow, minX, &coverage[minX], maxX - minX + 1, color);
+            std::fill(coverage.begin() + minX, coverage.begin() + maxX + 1, 0);
+        }
+        minX = width;
+        maxX = -1;
+    };
+    
+    // Sample rows arrive top to bottom, so each pixel row is resolved as
+    // soon as the spans move past it
+    buffer.forEachMerged([&](int sy, int x1, int x2) {
+        int row = sy / scale;
+        if (row != currentRow) {
+            if (currentRow >= 0) flushRow();
+            currentRow = row;
+        }
+        x1 = std::max(x1, 0);
+        x2 = std::min(x2, maxSample);
+        if (x1 > x2) return;
+        
+        int first = x1 / scale;
+        int last = x2 / scale;
+        minX = std::min(minX, first);
+        maxX = std::max(maxX, last);
+        if (first == last) {
+            coverage[first] += static_cast<uint8_t>(x2 - x1 + 1);
+            return;
+        }
+        coverage[first] += static_cast<uint8_t>(scale - x1 % scale);
+        for (int x = first + 1; x < last; ++x) {
+            coverage[x] += static_cast<uint8_t>(scale);
+        }
+        coverage[last] += static_cast<uint8_t>(x2 % scale + 1);
+    });
+    if (currentRow >= 0) flushRow();
+}
+
+} // namespace
+
+Canvas::Canvas(int width, int height, const Color& bgColor)
+    : width(width), height(height), backgroundColor(bgColor), antiAliased(false) {
+    pixels.assign(static_cast<size_t>(width) * height, bgColor);
+}
+
+void Canvas::clear() {
+    PixelKernels::fill(pixels.data(), pixels.size(), backgroundColor);
+}
+
 void Canvas::setPixel(int x, int y, const Color& color) {
     if (x >= 0 && x < width && y >= 0 && y < height) {
-        pixels[y][x] = color;
-        
-        // Also update ASCII buffer
-        int ax = x / 2;
-        int ay = y / 4;
-        if (ax < static_cast<int>(asciiBuffer[0].size()) && ay < static_cast<int>(asciiBuffer.size())) {
-            asciiBuffer[ay][ax] = '#';
-            asciiFgColors[ay][ax] = color;
+        Color& dst = pixels[static_cast<size_t>(y) * width + x];
+        if (color.isOpaque()) {
+            dst = color;
+        } else {
+            PixelKernels::blendSolid(&dst, 1, color);
         }
     }
 }
 
-Color Canvas::getPixel(int x, int y) const {
-    if (x >= 0 && x < width && y >= 0 && y < height) {
-        return pixels[y][x];
+void Canvas::blendPixel(int x, int y, const Color& color, uint8_t alpha) {
+    // Coverage and the color's own alpha combine multiplicatively
+    if (!color.isOpaque()) {
+        alpha = static_cast<uint8_t>((alpha * color.a + 127) / 255);
     }
-    return backgroundColor;
+    if (alpha == 255) {
+        setPixel(x, y, color);
+        return;
+    }
+    if (alpha == 0 || x < 0 || x >= width || y < 0 || y >= height) {
+        return;
+    }
+    
+    PixelKernels::blendCoverage(&pixels[static_cast<size_t>(y) * width + x], &alpha, 1, color);
 }
 
-void Canvas::setAscii(int x, int y, char ch, const Color& color) {
-    int ax = x / 2;
-    int ay = y / 4;
-    if (ax >= 0 && ax < static_cast<int>(asciiBuffer[0].size()) && 
-        ay >= 0 && ay < static_cast<int>(asciiBuffer.size())) {
-        asciiBuffer[ay][ax] = ch;
-        asciiFgColors[ay][ax] = color;
+Color Canvas::getPixel(int x, int y) const {
+    if (x >= 0 && x < width && y >= 0 && y < height) {
+        return pixels[static_cast<size_t>(y) * width + x];
     }
+    return backgroundColor;
 }
 
 void Canvas::fillRect(int x, int y, int w, int h, const Color& color) {
+    SLIDESHOW_PROFILE_SCOPE(CANVAS_FILL_RECT);
     for (int py = y; py < y + h; ++py) {
-        for (int px = x; px < x + w; ++px) {
-            setPixel(px, py, color);
-        }
+        fillSpan(py, x, x + w - 1, color);
     }
 }
 
 void Canvas::drawRect(int x, int y, int w, int h, const Color& color, int thickness) {
+    SLIDESHOW_PROFILE_SCOPE(CANVAS_DRAW_RECT);
+    if (w <= 0 || h <= 0 || thickness <= 0) return;
+    
+    // Edges are merged per row so a translucent border is not blended twice
+    // where edges meet
+    SpanBuffer buffer(std::min(y, y + h - thickness), std::max(y + thickness - 1, y + h - 1));
+    
     // Top and bottom edges
     for (int t = 0; t < thickness; ++t) {
-        for (int px = x; px < x + w; ++px) {
-            setPixel(px, y + t, color);
-            setPixel(px, y + h - 1 - t, color);
-        }
+        buffer.add(y + t, x, x + w - 1);
+        buffer.add(y + h - 1 - t, x, x + w - 1);
     }
     // Left and right edges
-    for (int t = 0; t < thickness; ++t) {
-        for (int py = y; py < y + h; ++py) {
-            setPixel(x + t, py, color);
-            setPixel(x + w - 1 - t, py, color);
+    for (int py = y; py < y + h; ++py) {
+        buffer.add(py, x, x + thickness - 1);
+        buffer.add(py, x + w - thickness, x + w - 1);
+    }
+    buffer.forEachMerged([&](int row, int x1, int x2) {
+        fillSpan(row, x1, x2, color);
+    });
+}
+
+void Canvas::fillSpan(int y, int x1, int x2, const Color& color) {
+    if (y < 0 || y >= height) return;
+    x1 = std::max(x1, 0);
+    x2 = std::min(x2, width - 1);
+    if (x1 > x2) return;
+    Color* dst = &pixels[static_cast<size_t>(y) * width + x1];
+    if (color.isOpaque()) {
+        PixelKernels::fill(dst, x2 - x1 + 1, color);
+    } else {
+        PixelKernels::blendSolid(dst, x2 - x1 + 1, color);
+    }
+}
+
+void Canvas::blendSpan(int y, int x, const uint8_t* alpha, int count, const Color& color) {
+    if (y < 0 || y >= height) return;
+    if (x < 0) {
+        alpha -= x;
+        count += x;
+        x = 0;
+    }
+    count = std::min(count, width - x);
+    if (count <= 0) return;
+    
+    PixelKernels::blendCoverage(&pixels[static_cast<size_t>(y) * width + x], alpha, count, color);
+}
+
+void Canvas::quadricHalfWidths(int64_t a, int64_t b, int64_t c, int rows, int maxX,
+                               std::vector<int>& out) {
+    // Largest dx with a*dx^2 + b*dy^2 <= c for each row dy. dx never grows as
+    // dy increases, so a single decreasing walk covers all rows.
+    out.assign(rows + 1, -1);
+    int dx = maxX;
+    for (int dy = 0; dy <= rows; ++dy) {
+        int64_t rowTerm = b * dy * dy;
+        while (dx >= 0 && a * dx * dx + rowTerm > c) {
+            --dx;
         }
+        if (dx < 0) break;
+        out[dy] = dx;
     }
 }
 
-void Canvas::fillCircle(int cx, int cy, int radius, const Color& color) {
-    for (int py = -radius; py <= radius; ++py) {
-        for (int px = -radius; px <= radius; ++px) {
-            if (px * px + py * py <= radius * radius) {
-                setPixel(cx + px, cy + py, color);
-            }
+void Canvas::fillRing(int cx, int cy, const std::vector<int>& outer, const std::vector<int>& inner,
+                      const Color& color) {
+    int rows = static_cast<int>(outer.size()) - 1;
+    for (int dy = -rows; dy <= rows; ++dy) {
+        int row = std::abs(dy);
+        int xo = outer[row];
+        if (xo < 0) continue;
+        int xi = row < static_cast<int>(inner.size()) ? inner[row] : -1;
+        if (xi < 0) {
+            fillSpan(cy + dy, cx - xo, cx + xo, color);
+        } else if (xi < xo) {
+            fillSpan(cy + dy, cx - xo, cx - xi - 1, color);
+            fillSpan(cy + dy, cx + xi + 1, cx + xo, color);
         }
     }
 }
 
+void Canvas::fillCircle(int cx, int cy, int radius, const Color& color) {
+    SLIDESHOW_PROFILE_SCOPE(CANVAS_FILL_CIRCLE);
+    if (radius < 0) return;
+    if (antiAliased) {
+        fillEllipseAA(cx, cy, radius, radius, 0, 0, color);
+        return;
+    }
+    std::vector<int> spans;
+    quadricHalfWidths(1, 1, static_cast<int64_t>(radius) * radius, radius, radius, spans);
+    fillRing(cx, cy, spans, {}, color);
+}
+
 void Canvas::drawCircle(int cx, int cy, int radius, const Color& color, int thickness) {
-    for (int py = -radius - thickness; py <= radius + thickness; ++py) {
-        for (int px = -radius - thickness; px <= radius + thickness; ++px) {
-            int distSq = px * px + py * py;
-            int outerR = radius;
-            int innerR = radius - thickness;
-            if (distSq <= outerR * outerR && distSq >= innerR * innerR) {
-                setPixel(cx + px, cy + py, color);
-            }
-        }
+    SLIDESHOW_PROFILE_SCOPE(CANVAS_DRAW_CIRCLE);
+    if (radius < 0) return;
+    // Ring of pixels with innerR^2 <= d^2 <= radius^2
+    int innerR = radius - thickness;
+    if (antiAliased) {
+        fillEllipseAA(cx, cy, radius, radius, std::abs(innerR), std::abs(innerR), color);
+        return;
+    }
+    int64_t innerSq = static_cast<int64_t>(innerR) * innerR;
+    std::vector<int> outer, inner;
+    quadricHalfWidths(1, 1, static_cast<int64_t>(radius) * radius, radius, radius, outer);
+    if (innerSq > 0) {
+        int innerRows = std::abs(innerR);
+        quadricHalfWidths(1, 1, innerSq - 1, innerRows, innerRows, inner);
     }
+    fillRing(cx, cy, outer, inner, color);
 }
 
 void Canvas::fillEllipse(int cx, int cy, int rx, int ry, const Color& color) {
-    for (int py = -ry; py <= ry; ++py) {
-        for (int px = -rx; px <= rx; ++px) {
-            double test = (double)(px * px) / (rx * rx) + (double)(py * py) / (ry * ry);
-            if (test <= 1.0) {
-                setPixel(cx + px, cy + py, color);
-            }
-        }
+    SLIDESHOW_PROFILE_SCOPE(CANVAS_FILL_ELLIPSE);
+    if (rx <= 0 || ry <= 0) return;
+    if (antiAliased) {
+        fillEllipseAA(cx, cy, rx, ry, 0, 0, color);
+        return;
     }
+    int64_t rx2 = static_cast<int64_t>(rx) * rx;
+    int64_t ry2 = static_cast<int64_t>(ry) * ry;
+    std::vector<int> spans;
+    quadricHalfWidths(ry2, rx2, rx2 * ry2, ry, rx, spans);
+    fillRing(cx, cy, spans, {}, color);
+}
+
+void Canvas::drawEllipse(int cx, int cy, int rx, int ry, const Color& color, int thickness) {
+    SLIDESHOW_PROFILE_SCOPE(CANVAS_DRAW_ELLIPSE);
+    if (rx <= 0 || ry <= 0) return;
+    int64_t rx2 = static_cast<int64_t>(rx) * rx;
+    int64_t ry2 = static_cast<int64_t>(ry) * ry;
+    std::vector<int> outer, inner;
+    quadricHalfWidths(ry2, rx2, rx2 * ry2, ry, rx, outer);
+    
+    // Pixels on or inside the inner ellipse are left untouched. Like the old
+    // per-pixel test, the inner radii are only ever used squared.
+    int irx = std::abs(rx - thickness);
+    int iry = std::abs(ry - thickness);
+    if (antiAliased) {
+        fillEllipseAA(cx, cy, rx, ry, irx, iry, color);
+        return;
+    }
+    if (irx > 0 && iry > 0) {
+        int64_t irx2 = static_cast<int64_t>(irx) * irx;
+        int64_t iry2 = static_cast<int64_t>(iry) * iry;
+        quadricHalfWidths(iry2, irx2, irx2 * iry2, iry, irx, inner);
+    }
+    fillRing(cx, cy, outer, inner, color);
+}
+
+void Canvas::fillEllipseAA(int cx, int cy, int rx, int ry, int irx, int iry, const Color& color) {
+    const int scale = kAASamples;
+    SpanBuffer buffer(std::max(static_cast<int>(toSample(cy - ry, scale)) - 1, 0),
+                      std::min(static_cast<int>(toSample(cy + ry, scale)) + 1, height * scale - 1));
+    addEllipseSpans(buffer, toSample(cx, scale), toSample(cy, scale),
+                    rx * scale, ry * scale, irx * scale, iry * scale);
+    paintSpans(*this, buffer, scale, color);
 }
 
 void Canvas::drawLine(int x1, int y1, int x2, int y2, const Color& color, int thickness) {
-    // Bresenham's line algorithm with thickness
+    SLIDESHOW_PROFILE_SCOPE(CANVAS_DRAW_LINE);
+    if (thickness > 1 || antiAliased) {
+        drawPolygonStroke({{x1, y1}, {x2, y2}}, false, color, thickness);
+        return;
+    }
+    
+    // Bresenham's line algorithm for hairlines
     int dx = std::abs(x2 - x1);
     int dy = std::abs(y2 - y1);
     int sx = (x1 < x2) ? 1 : -1;
@@ -126,12 +459,7 @@ void Canvas::drawLine(int x1, int y1, int x2, int y2, const Color& color, int th
     int err = dx - dy;
     
     while (true) {
-        // Draw thick point
-        for (int ty = -thickness / 2; ty <= thickness / 2; ++ty) {
-            for (int tx = -thickness / 2; tx <= thickness / 2; ++tx) {
-                setPixel(x1 + tx, y1 + ty, color);
-            }
-        }
+        setPixel(x1, y1, color);
         
         if (x1 == x2 && y1 == y2) break;
         
@@ -147,7 +475,46 @@ void Canvas::drawLine(int x1, int y1, int x2, int y2, const Color& color, int th
     }
 }
 
+void Canvas::drawPolygonStroke(const std::vector<std::pair<int, int>>& points, bool closed,
+                               const Color& color, int thickness) {
+    if (points.empty()) return;
+    
+    // Stroke half width matches the old (thickness / 2) pixel stamp radius
+    const int scale = antiAliased ? kAASamples : 1;
+    double hw = (thickness / 2 + 0.5) * scale;
+    
+    int minY = points[0].second, maxY = points[0].second;
+    for (const auto& p : points) {
+        minY = std::min(minY, p.second);
+        maxY = std::max(maxY, p.second);
+    }
+    int pad = static_cast<int>(std::ceil(hw)) + 1;
+    SpanBuffer buffer(std::max(static_cast<int>(toSample(minY, scale)) - pad, 0),
+                      std::min(static_cast<int>(toSample(maxY, scale)) + pad, height * scale - 1));
+    
+    int n = static_cast<int>(points.size());
+    int segments = closed ? n : n - 1;
+    for (int i = 0; i < segments; ++i) {
+        const auto& a = points[i];
+        const auto& b = points[(i + 1) % n];
+        addSegmentSpans(buffer, toSample(a.first, scale), toSample(a.second, scale),
+                        toSample(b.first, scale), toSample(b.second, scale), hw);
+    }
+    // Round joins at every vertex (and round caps on open paths)
+    for (const auto& p : points) {
+        addEllipseSpans(buffer, toSample(p.first, scale), toSample(p.second, scale), hw, hw);
+    }
+    
+    paintSpans(*this, buffer, scale, color);
+}
+
 void Canvas::fillTriangle(int x1, int y1, int x2, int y2, int x3, int y3, const Color& color) {
+    SLIDESHOW_PROFILE_SCOPE(CANVAS_FILL_TRIANGLE);
+    if (antiAliased) {
+        fillPolygonAA({{x1, y1}, {x2, y2}, {x3, y3}}, color);
+        return;
+    }
+    
     // Sort vertices by y-coordinate
     if (y1 > y2) { std::swap(x1, x2); std::swap(y1, y2); }
     if (y1 > y3) { std::swap(x1, x3); std::swap(y1, y3); }
@@ -193,7 +560,12 @@ bool Canvas::pointInPolygon(int px, int py, const std::vector<std::pair<int, int
 }
 
 void Canvas::fillPolygon(const std::vector<std::pair<int, int>>& points, const Color& color) {
+    SLIDESHOW_PROFILE_SCOPE(CANVAS_FILL_POLYGON);
     if (points.empty()) return;
+    if (antiAliased) {
+        fillPolygonAA(points, color);
+        return;
+    }
     
     // Find bounding box
     int minX = points[0].first, maxX = points[0].first;
@@ -216,7 +588,30 @@ void Canvas::fillPolygon(const std::vector<std::pair<int, int>>& points, const C
     }
 }
 
+void Canvas::fillPolygonAA(const std::vector<std::pair<int, int>>& points, const Color& color) {
+    const int scale = kAASamples;
+    std::vector<std::pair<double, double>> samples;
+    samples.reserve(points.size());
+    int minY = points[0].second, maxY = points[0].second;
+    for (const auto& p : points) {
+        samples.push_back({toSample(p.first, scale), toSample(p.second, scale)});
+        minY = std::min(minY, p.second);
+        maxY = std::max(maxY, p.second);
+    }
+    
+    SpanBuffer buffer(std::max(static_cast<int>(toSample(minY, scale)) - 1, 0),
+                      std::min(static_cast<int>(toSample(maxY, scale)) + 1, height * scale - 1));
+    addPolygonSpans(buffer, samples);
+    paintSpans(*this, buffer, scale, color);
+}
+
 void Canvas::drawPolygon(const std::vector<std::pair<int, int>>& points, const Color& color, int thickness) {
+    SLIDESHOW_PROFILE_SCOPE(CANVAS_DRAW_POLYGON);
+    if (thickness > 1 || antiAliased) {
+        drawPolygonStroke(points, true, color, thickness);
+        return;
+    }
+    
     int n = static_cast<int>(points.size());
     for (int i = 0; i < n; ++i) {
         int next = (i + 1) % n;
@@ -226,6 +621,9 @@ void Canvas::drawPolygon(const std::vector<std::pair<int, int>>& points, const C
 }
 
 bool Canvas::exportBMP(const std::string& filename) const {
+    SLIDESHOW_PROFILE_SCOPE(EXPORT_BMP);
+    Tracer::Span span("io", "Canvas::exportBMP");
+    span.arg("file", filename);
     std::ofstream file(filename, std::ios::binary);
     if (!file.is_open()) {
         return false;
@@ -273,48 +671,106 @@ bool Canvas::exportBMP(const std::string& filename) const {
     };
     file.write(reinterpret_cast<char*>(dibHeader), 40);
     
-    // Pixel data (bottom-up, BGR format)
-    std::vector<uint8_t> row(rowSize, 0);
-    for (int y = height - 1; y >= 0; --y) {
-        for (int x = 0; x < width; ++x) {
-            const Color& c = pixels[y][x];
-            row[x * 3 + 0] = c.b;  // Blue
-            row[x * 3 + 1] = c.g;  // Green
-            row[x * 3 + 2] = c.r;  // Red
+    // Pixel data (bottom-up, BGR format), converted in one pass and written in one call
+    std::vector<uint8_t> image(static_cast<size_t>(imageSize), 0);
+    {
+        Tracer::Span encode("io", "encode BGR");
+        for (int y = height - 1; y >= 0; --y) {
+            uint8_t* row = &image[static_cast<size_t>(height - 1 - y) * rowSize];
+            PixelKernels::rgbToBgr(&pixels[static_cast<size_t>(y) * width], row, width);
         }
-        file.write(reinterpret_cast<char*>(row.data()), rowSize);
     }
+
+    Tracer::Span write("io", "file write");
+    write.arg("bytes", static_cast<int64_t>(fileSize));
+    file.write(reinterpret_cast<char*>(image.data()), imageSize);
     
     file.close();
     return true;
 }
 
+bool Canvas::sampleAsciiCell(int ax, int ay, Color& out) const {
+    // Collect the cell's pixels that differ from the background
+    Color found[kAsciiCellWidth * kAsciiCellHeight];
+    int counts[kAsciiCellWidth * kAsciiCellHeight];
+    int distinct = 0;
+    for (int py = ay * kAsciiCellHeight; py < (ay + 1) * kAsciiCellHeight; ++py) {
+        const Color* row = &pixels[static_cast<size_t>(py) * width];
+        for (int px = ax * kAsciiCellWidth; px < (ax + 1) * kAsciiCellWidth; ++px) {
+            const Color& c = row[px];
+            if (c == backgroundColor) continue;
+            int k = 0;
+            while (k < distinct && !(found[k] == c)) ++k;
+            if (k == distinct) {
+                found[distinct] = c;
+                counts[distinct++] = 0;
+            }
+            ++counts[k];
+        }
+    }
+    if (distinct == 0) return false;
+    
+    // Majority color wins; ties go to the color seen first
+    int best = 0;
+    for (int k = 1; k < distinct; ++k) {
+        if (counts[k] > counts[best]) best = k;
+    }
+    out = found[best];
+    return true;
+}
+
 std::string Canvas::toAsciiArt() const {
+    int asciiWidth = getAsciiWidth();
+    int asciiHeight = getAsciiHeight();
+    const std::string border = Color(100, 100, 120).toAnsiFg();
+    const std::string blank = backgroundColor.toAnsiFg();
+    
+    // Worst case every cell switches color: escape plus a 3-byte block
     std::string result;
+    result.reserve(static_cast<size_t>(asciiWidth + 4) * (asciiHeight + 2) * 24);
     
     // Top border
-    result += Color(100, 100, 120).toAnsiFg();
-    result += "+" + std::string(asciiBuffer[0].size(), '-') + "+\n";
-    
-    for (size_t y = 0; y < asciiBuffer.size(); ++y) {
-        result += Color(100, 100, 120).toAnsiFg() + "|";
-        for (size_t x = 0; x < asciiBuffer[y].size(); ++x) {
-            char ch = asciiBuffer[y][x];
-            if (ch != ' ') {
-                result += asciiFgColors[y][x].toAnsiFg();
+    result += border;
+    result += '+';
+    result.append(asciiWidth, '-');
+    result += "+\n";
+    
+    // Escapes are only written when the color changes along a row
+    Color cell;
+    for (int y = 0; y < asciiHeight; ++y) {
+        result += border;
+        result += '|';
+        Color current;
+        bool haveColor = false;
+        for (int x = 0; x < asciiWidth; ++x) {
+            if (sampleAsciiCell(x, y, cell)) {
+                if (!haveColor || !(current == cell)) {
+                    cell.appendAnsiFg(result);
+                    current = cell;
+                    haveColor = true;
+                }
                 // Use block characters for better visual
                 result += "\u2588";  // Full block
             } else {
-                result += backgroundColor.toAnsiFg() + " ";
+                if (!haveColor || !(current == backgroundColor)) {
+                    result += blank;
+                    current = backgroundColor;
+                    haveColor = true;
+                }
+                result += ' ';
             }
         }
-        result += Color(100, 100, 120).toAnsiFg() + "|\n";
+        result += border;
+        result += "|\n";
     }
     
     // Bottom border
-    result += Color(100, 100, 120).toAnsiFg();
-    result += "+" + std::string(asciiBuffer[0].size(), '-') + "+";
-    result += Color::resetAnsi() + "\n";
+    result += border;
+    result += '+';
+    result.append(asciiWidth, '-');
+    result += '+';
+    result += Color::resetAnsi();
+    result += '\n';
     
     return result;
 }
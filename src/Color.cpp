@@ -1,60 +1,357 @@
 #include "Color.h"
 #include <algorithm>
 #include <cctype>
-#include <sstream>
-
-const std::map<std::string, Color>& Color::getColorMap() {
-    static const std::map<std::string, Color> colors = {
-        {"red", Red()},
-        {"green", Green()},
-        {"blue", Blue()},
-        {"yellow", Yellow()},
-        {"cyan", Cyan()},
-        {"magenta", Magenta()},
-        {"orange", Orange()},
-        {"purple", Purple()},
-        {"pink", Pink()},
-        {"white", White()},
-        {"black", Black()},
-        {"gray", Gray()},
-        {"grey", Gray()},
-        {"brown", Brown()},
-        {"gold", Gold()},
-        {"silver", Silver()},
-        {"navy", Navy()},
-        {"teal", Teal()},
-        {"lime", Lime()},
-        {"coral", Coral()},
-        {"violet", Violet()}
-    };
-    return colors;
+#include <cstddef>
+
+namespace {
+
+// Writes a byte in decimal, as the escape sequences expect
+template <typename Out>
+void appendDecimal(Out& out, uint8_t value) {
+    if (value >= 100) out += static_cast<char>('0' + value / 100);
+    if (value >= 10) out += static_cast<char>('0' + value / 10 % 10);
+    out += static_cast<char>('0' + value % 10);
+}
+
+template <typename Out>
+void appendAnsi(Out& out, const char* prefix, const Color& color) {
+    out += prefix;
+    appendDecimal(out, color.r);
+    out += ';';
+    appendDecimal(out, color.g);
+    out += ';';
+    appendDecimal(out, color.b);
+    out += 'm';
+}
+
+/**
+ * @brief Fixed-size, direct-mapped cache of formatted escapes
+ * Each color maps to one slot; a different color landing in the same slot
+ * replaces it, so memory stays bounded however many blended colors are
+ * formatted.
+ */
+struct AnsiCache {
+    static constexpr size_t kSlots = 256;
+
+    uint32_t keys[kSlots] = {};  // Packed RGB plus a valid bit
+    AnsiEscape escapes[kSlots];
+
+    AnsiEscape get(const char* prefix, const Color& color) {
+        uint32_t key = 0x1000000u | (static_cast<uint32_t>(color.r) << 16) | (color.g << 8) | color.b;
+        size_t slot = (key * 2654435761u) >> 24;
+        if (keys[slot] != key) {
+            keys[slot] = key;
+            escapes[slot] = AnsiEscape();
+            appendAnsi(escapes[slot], prefix, color);
+        }
+        return escapes[slot];
+    }
+};
+
+// ============== Named Color Tables ==============
+
+struct NamedColor {
+    const char* name;         // Lowercase lookup key
+    const char* displayName;  // What getName() reports
+    Color color;
+};
+
+// Where two names share a color, the first one listed is reported
+constexpr NamedColor kNamedColors[] = {
+    {"black", "Black", Color::Black()},
+    {"blue", "Blue", Color::Blue()},
+    {"brown", "Brown", Color::Brown()},
+    {"coral", "Coral", Color::Coral()},
+    {"cyan", "Cyan", Color::Cyan()},
+    {"gold", "Gold", Color::Gold()},
+    {"gray", "Gray", Color::Gray()},
+    {"green", "Green", Color::Green()},
+    {"grey", "Grey", Color::Gray()},
+    {"lime", "Lime", Color::Lime()},
+    {"magenta", "Magenta", Color::Magenta()},
+    {"navy", "Navy", Color::Navy()},
+    {"orange", "Orange", Color::Orange()},
+    {"pink", "Pink", Color::Pink()},
+    {"purple", "Purple", Color::Purple()},
+    {"red", "Red", Color::Red()},
+    {"silver", "Silver", Color::Silver()},
+    {"teal", "Teal", Color::Teal()},
+    {"violet", "Violet", Color::Violet()},
+    {"white", "White", Color::White()},
+    {"yellow", "Yellow", Color::Yellow()}
+};
+
+constexpr int kNamedColorCount = static_cast<int>(sizeof(kNamedColors) / sizeof(kNamedColors[0]));
+
+// Both hash tables have this many slots (a power of two, at least 2x the names)
+constexpr size_t kTableSlots = 64;
+
+constexpr size_t nameLength(const char* name) {
+    size_t length = 0;
+    while (name[length] != '\0') ++length;
+    return length;
+}
+
+constexpr size_t longestName() {
+    size_t longest = 0;
+    for (const auto& named : kNamedColors) {
+        longest = std::max(longest, nameLength(named.name));
+    }
+    return longest;
+}
+
+constexpr size_t kMaxNameLength = longestName();
+
+// FNV-1a with a tunable starting value
+constexpr uint32_t hashName(const char* name, size_t length, uint32_t seed) {
+    uint32_t hash = seed;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<uint8_t>(name[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Finds a seed for which every name lands in its own slot
+ * Runs at compile time, which makes the name table a perfect hash.
+ */
+constexpr uint32_t findNameSeed() {
+    for (uint32_t seed = 2166136261u;; ++seed) {
+        bool used[kTableSlots] = {};
+        bool collision = false;
+        for (const auto& named : kNamedColors) {
+            size_t slot = hashName(named.name, nameLength(named.name), seed) & (kTableSlots - 1);
+            if (used[slot]) {
+                collision = true;
+                break;
+            }
+            used[slot] = true;
+        }
+        if (!collision) return seed;
+    }
+}
+
+constexpr uint32_t kNameSeed = findNameSeed();
+
+struct SlotTable {
+    int8_t slots[kTableSlots];
+};
+
+// Name slot -> index into kNamedColors, -1 when empty
+constexpr SlotTable buildNameTable() {
+    SlotTable table = {};
+    for (auto& slot : table.slots) slot = -1;
+    for (int i = 0; i < kNamedColorCount; ++i) {
+        const char* name = kNamedColors[i].name;
+        table.slots[hashName(name, nameLength(name), kNameSeed) & (kTableSlots - 1)] = static_cast<int8_t>(i);
+    }
+    return table;
+}
+
+constexpr SlotTable kNameTable = buildNameTable();
+
+constexpr uint32_t packRGB(const Color& color) {
+    return (static_cast<uint32_t>(color.r) << 16) | (static_cast<uint32_t>(color.g) << 8) | color.b;
+}
+
+constexpr size_t colorSlot(uint32_t key) {
+    return static_cast<size_t>((key * 2654435761u) >> 26) & (kTableSlots - 1);
+}
+
+// Packed RGB -> index into kNamedColors with linear probing, -1 when empty
+constexpr SlotTable buildColorTable() {
+    SlotTable table = {};
+    for (auto& slot : table.slots) slot = -1;
+    for (int i = 0; i < kNamedColorCount; ++i) {
+        uint32_t key = packRGB(kNamedColors[i].color);
+        size_t slot = colorSlot(key);
+        bool duplicate = false;
+        while (table.slots[slot] >= 0) {
+            if (packRGB(kNamedColors[table.slots[slot]].color) == key) {
+                duplicate = true;
+                break;
+            }
+            slot = (slot + 1) & (kTableSlots - 1);
+        }
+        if (!duplicate) table.slots[slot] = static_cast<int8_t>(i);
+    }
+    return table;
+}
+
+constexpr SlotTable kColorTable = buildColorTable();
+
+/**
+ * @brief Looks up a lowercase name, returning its kNamedColors index or -1
+ */
+int findNamedColor(const char* name, size_t length) {
+    int index = kNameTable.slots[hashName(name, length, kNameSeed) & (kTableSlots - 1)];
+    if (index < 0) return -1;
+    const char* candidate = kNamedColors[index].name;
+    return nameLength(candidate) == length && std::equal(name, name + length, candidate) ? index : -1;
+}
+
+/**
+ * @brief Looks up an exact RGB value, returning its kNamedColors index or -1
+ */
+int findColorIndex(const Color& color) {
+    uint32_t key = packRGB(color);
+    for (size_t slot = colorSlot(key);; slot = (slot + 1) & (kTableSlots - 1)) {
+        int index = kColorTable.slots[slot];
+        if (index < 0 || packRGB(kNamedColors[index].color) == key) return index;
+    }
+}
+
+// ============== Parsing ==============
+
+/**
+ * @brief Parses a color name (any case) from text[0, length)
+ */
+bool parseName(const char* text, size_t length, Color& out) {
+    // Names are short, so an overlong input cannot match and skips hashing
+    char lower[kMaxNameLength];
+    if (length == 0 || length > kMaxNameLength) return false;
+    for (size_t i = 0; i < length; ++i) {
+        lower[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(text[i])));
+    }
+    int index = findNamedColor(lower, length);
+    if (index < 0) return false;
+    out = kNamedColors[index].color;
+    return true;
 }
 
-Color::Color(const std::string& colorName) {
-    std::string lower = colorName;
-    std::transform(lower.begin(), lower.end(), lower.begin(),
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * @brief Parses "#RRGGBB" or "#RRGGBBAA" from text[0, length)
+ */
+bool parseHex(const char* text, size_t length, Color& out) {
+    if ((length != 7 && length != 9) || text[0] != '#') return false;
+    uint8_t channels[4] = {0, 0, 0, 255};
+    for (size_t i = 1, c = 0; i < length; i += 2, ++c) {
+        int high = hexValue(text[i]);
+        int low = hexValue(text[i + 1]);
+        if (high < 0 || low < 0) return false;
+        channels[c] = static_cast<uint8_t>(high * 16 + low);
+    }
+    out = Color(channels[0], channels[1], channels[2], channels[3]);
+    return true;
+}
+
+/**
+ * @brief Parses an unsigned decimal at text[pos], skipping spaces around it
+ * @return False if there is no number or it exceeds max
+ */
+bool parseNumber(const std::string& text, size_t& pos, int max, int& value) {
+    while (pos < text.size() && text[pos] == ' ') ++pos;
+    size_t start = pos;
+    value = 0;
+    while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos]))) {
+        value = value * 10 + (text[pos] - '0');
+        if (value > max) return false;
+        ++pos;
+    }
+    while (pos < text.size() && text[pos] == ' ') ++pos;
+    return pos > start && std::isdigit(static_cast<unsigned char>(text[start]));
+}
+
+/**
+ * @brief Parses "RGB(r,g,b)" or "RGBA(r,g,b,a)" in any case
+ */
+bool parseFunctional(const std::string& text, Color& out) {
+    size_t open = text.find('(');
+    if (open == std::string::npos || text.back() != ')') return false;
+    std::string prefix = text.substr(0, open);
+    std::transform(prefix.begin(), prefix.end(), prefix.begin(),
                    [](unsigned char c) { return std::tolower(c); });
+    size_t count = prefix == "rgb" ? 3 : prefix == "rgba" ? 4 : 0;
+    if (count == 0) return false;
     
-    const auto& colors = getColorMap();
-    auto it = colors.find(lower);
-    if (it != colors.end()) {
-        *this = it->second;
-    } else {
-        // Default to white if color not found
-        *this = White();
+    int channels[4] = {0, 0, 0, 255};
+    size_t pos = open + 1;
+    for (size_t c = 0; c < count; ++c) {
+        if (!parseNumber(text, pos, 255, channels[c])) return false;
+        char expected = c + 1 < count ? ',' : ')';
+        if (pos >= text.size() || text[pos] != expected) return false;
+        ++pos;
     }
+    if (pos != text.size()) return false;
+    out = Color(static_cast<uint8_t>(channels[0]), static_cast<uint8_t>(channels[1]),
+                static_cast<uint8_t>(channels[2]), static_cast<uint8_t>(channels[3]));
+    return true;
 }
 
-std::string Color::toAnsiFg() const {
-    std::ostringstream oss;
-    oss << "\033[38;2;" << (int)r << ";" << (int)g << ";" << (int)b << "m";
-    return oss.str();
+/**
+ * @brief Parses an alpha suffix: 0-255, or 0-100 followed by '%'
+ */
+bool parseAlpha(const std::string& text, size_t pos, uint8_t& alpha) {
+    bool percent = !text.empty() && text.back() == '%';
+    std::string digits = text.substr(pos, text.size() - pos - (percent ? 1 : 0));
+    size_t digitPos = 0;
+    int value = 0;
+    if (!parseNumber(digits, digitPos, percent ? 100 : 255, value) || digitPos != digits.size()) {
+        return false;
+    }
+    alpha = static_cast<uint8_t>(percent ? (value * 255 + 50) / 100 : value);
+    return true;
 }
 
-std::string Color::toAnsiBg() const {
-    std::ostringstream oss;
-    oss << "\033[48;2;" << (int)r << ";" << (int)g << ";" << (int)b << "m";
-    return oss.str();
+bool parseColor(const std::string& text, Color& out) {
+    if (text.empty()) return false;
+    if (text.back() == ')') {
+        return parseFunctional(text, out);
+    }
+    
+    size_t at = text.find('@');
+    size_t baseLength = at == std::string::npos ? text.size() : at;
+    bool parsed = text[0] == '#' ? parseHex(text.data(), baseLength, out)
+                                 : parseName(text.data(), baseLength, out);
+    if (!parsed) return false;
+    if (at != std::string::npos) {
+        uint8_t alpha = 255;
+        if (!parseAlpha(text, at + 1, alpha)) return false;
+        out.a = alpha;
+    }
+    return true;
+}
+
+void appendHexByte(std::string& out, uint8_t value) {
+    const char* digits = "0123456789ABCDEF";
+    out += digits[value >> 4];
+    out += digits[value & 0xF];
+}
+
+} // namespace
+
+Color::Color(const std::string& colorName) : Color() {
+    Color parsed;
+    if (parseColor(colorName, parsed)) {
+        *this = parsed;
+    }
+    // Otherwise stay white, as for an unknown name
+}
+
+AnsiEscape Color::toAnsiFg() const {
+    thread_local AnsiCache cache;
+    return cache.get("\033[38;2;", *this);
+}
+
+AnsiEscape Color::toAnsiBg() const {
+    thread_local AnsiCache cache;
+    return cache.get("\033[48;2;", *this);
+}
+
+void Color::appendAnsiFg(std::string& out) const {
+    appendAnsi(out, "\033[38;2;", *this);
+}
+
+void Color::appendAnsiBg(std::string& out) const {
+    appendAnsi(out, "\033[48;2;", *this);
 }
 
 std::string Color::resetAnsi() {
@@ -62,24 +359,46 @@ std::string Color::resetAnsi() {
 }
 
 std::string Color::getName() const {
-    const auto& colors = getColorMap();
-    for (const auto& pair : colors) {
-        if (pair.second == *this) {
-            std::string name = pair.first;
-            if (!name.empty()) {
-                name[0] = std::toupper(name[0]);
-            }
-            return name;
+    int index = findColorIndex(*this);
+    if (index >= 0) {
+        std::string name = kNamedColors[index].displayName;
+        if (a != 255) {
+            name += '@';
+            appendDecimal(name, a);
         }
+        return name;
     }
     // Return RGB format if not a named color
-    std::ostringstream oss;
-    oss << "RGB(" << (int)r << "," << (int)g << "," << (int)b << ")";
-    return oss.str();
+    std::string name = a == 255 ? "RGB(" : "RGBA(";
+    appendDecimal(name, r);
+    name += ',';
+    appendDecimal(name, g);
+    name += ',';
+    appendDecimal(name, b);
+    if (a != 255) {
+        name += ',';
+        appendDecimal(name, a);
+    }
+    name += ')';
+    return name;
+}
+
+std::string Color::toString() const {
+    if (findColorIndex(*this) >= 0) {
+        return getName();
+    }
+    std::string text = "#";
+    appendHexByte(text, r);
+    appendHexByte(text, g);
+    appendHexByte(text, b);
+    if (a != 255) {
+        appendHexByte(text, a);
+    }
+    return text;
 }
 
 bool Color::operator==(const Color& other) const {
-    return r == other.r && g == other.g && b == other.b;
+    return r == other.r && g == other.g && b == other.b && a == other.a;
 }
 
 std::vector<std::string> Color::getAvailableColors() {
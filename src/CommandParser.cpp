@@ -1,17 +1,225 @@
 #include "CommandParser.h"
 #include "Tokenizer.h"
-#include <sstream>
 #include <algorithm>
+#include <cctype>
+#include <cstdint>
+
+namespace {
+
+// ============== Command Table ==============
+
+// Argument limit for commands that check their own arguments in main()
+constexpr uint8_t kAnyArgs = 255;
+
+struct CommandSpec {
+    const char* name;                  // Lowercase command word or alias
+    CommandParser::CommandType type;
+    uint8_t minArgs;                   // Outside [minArgs, maxArgs] parses as INVALID
+    uint8_t maxArgs;
+};
+
+constexpr CommandSpec kCommands[] = {
+    // Navigation commands
+    {"next", CommandParser::NEXT, 0, kAnyArgs},
+    {"n", CommandParser::NEXT, 0, kAnyArgs},
+    {"prev", CommandParser::PREV, 0, kAnyArgs},
+    {"p", CommandParser::PREV, 0, kAnyArgs},
+    {"previous", CommandParser::PREV, 0, kAnyArgs},
+    {"show", CommandParser::SHOW, 0, kAnyArgs},
+    {"s", CommandParser::SHOW, 0, kAnyArgs},
+    // goto <n>, or goto <file> <n> which parses as GOTO_FILE
+    {"goto", CommandParser::GOTO, 1, 2},
+    {"g", CommandParser::GOTO, 1, 2},
+    {"nextfile", CommandParser::NEXTFILE, 0, kAnyArgs},
+    {"nf", CommandParser::NEXTFILE, 0, kAnyArgs},
+    {"prevfile", CommandParser::PREVFILE, 0, kAnyArgs},
+    {"pf", CommandParser::PREVFILE, 0, kAnyArgs},
+
+    // Shape manipulation
+    {"add", CommandParser::ADD, 0, kAnyArgs},
+    {"a", CommandParser::ADD, 0, kAnyArgs},
+    {"delete", CommandParser::DELETE, 0, kAnyArgs},
+    {"del", CommandParser::DELETE, 0, kAnyArgs},
+    {"remove", CommandParser::DELETE, 0, kAnyArgs},
+    {"rm", CommandParser::DELETE, 0, kAnyArgs},
+    {"edit", CommandParser::EDIT, 0, kAnyArgs},
+    {"e", CommandParser::EDIT, 0, kAnyArgs},
+    {"modify", CommandParser::EDIT, 0, kAnyArgs},
+    {"list", CommandParser::LIST, 0, kAnyArgs},
+    {"ls", CommandParser::LIST, 0, kAnyArgs},
+    {"l", CommandParser::LIST, 0, kAnyArgs},
+    {"clear", CommandParser::CLEAR, 0, kAnyArgs},
+    {"move", CommandParser::MOVE, 0, kAnyArgs},
+    {"mv", CommandParser::MOVE, 0, kAnyArgs},
+    {"scale", CommandParser::SCALE, 0, kAnyArgs},
+    {"recolor", CommandParser::RECOLOR, 0, kAnyArgs},
+    {"duplicate", CommandParser::DUPLICATE, 0, kAnyArgs},
+    {"dup", CommandParser::DUPLICATE, 0, kAnyArgs},
+
+    // Slide manipulation
+    {"newslide", CommandParser::NEWSLIDE, 0, kAnyArgs},
+    {"ns", CommandParser::NEWSLIDE, 0, kAnyArgs},
+    {"addslide", CommandParser::NEWSLIDE, 0, kAnyArgs},
+    {"delslide", CommandParser::DELSLIDE, 0, kAnyArgs},
+    {"ds", CommandParser::DELSLIDE, 0, kAnyArgs},
+    {"removeslide", CommandParser::DELSLIDE, 0, kAnyArgs},
+
+    // View modes
+    {"visual", CommandParser::VISUAL, 0, kAnyArgs},
+    {"v", CommandParser::VISUAL, 0, kAnyArgs},
+    {"view", CommandParser::VISUAL, 0, kAnyArgs},
+    {"text", CommandParser::TEXT, 0, kAnyArgs},
+    {"t", CommandParser::TEXT, 0, kAnyArgs},
+
+    // Export commands
+    {"export", CommandParser::EXPORT, 0, kAnyArgs},
+    {"exp", CommandParser::EXPORT, 0, kAnyArgs},
+    {"exportall", CommandParser::EXPORT_ALL, 0, kAnyArgs},
+    {"expall", CommandParser::EXPORT_ALL, 0, kAnyArgs},
+    {"exportjson", CommandParser::EXPORT_JSON, 0, kAnyArgs},
+    {"expjson", CommandParser::EXPORT_JSON, 0, kAnyArgs},
+    {"json", CommandParser::EXPORT_JSON, 0, kAnyArgs},
+
+    // Theme/appearance
+    {"theme", CommandParser::THEME, 0, kAnyArgs},
+    {"colors", CommandParser::COLORS, 0, kAnyArgs},
+    {"shapes", CommandParser::SHAPES, 0, kAnyArgs},
+
+    // File operations
+    {"new", CommandParser::NEW, 0, kAnyArgs},
+    {"save", CommandParser::SAVE, 0, kAnyArgs},
+    {"saveas", CommandParser::SAVEAS, 0, kAnyArgs},
+
+    // Undo/Redo commands
+    {"undo", CommandParser::UNDO, 0, kAnyArgs},
+    {"u", CommandParser::UNDO, 0, kAnyArgs},
+    {"z", CommandParser::UNDO, 0, kAnyArgs},
+    {"redo", CommandParser::REDO, 0, kAnyArgs},
+    {"r", CommandParser::REDO, 0, kAnyArgs},
+    {"y", CommandParser::REDO, 0, kAnyArgs},
+    {"history", CommandParser::HISTORY, 0, kAnyArgs},
+    {"hist", CommandParser::HISTORY, 0, kAnyArgs},
+
+    // System commands
+    {"stats", CommandParser::STATS, 0, kAnyArgs},
+    {"help", CommandParser::HELP, 0, kAnyArgs},
+    {"h", CommandParser::HELP, 0, kAnyArgs},
+    {"?", CommandParser::HELP, 0, kAnyArgs},
+    {"exit", CommandParser::EXIT, 0, kAnyArgs},
+    {"quit", CommandParser::EXIT, 0, kAnyArgs},
+    {"q", CommandParser::EXIT, 0, kAnyArgs}
+};
+
+constexpr int kCommandCount = static_cast<int>(sizeof(kCommands) / sizeof(kCommands[0]));
+
+// Hash table slots (a power of two, at least 4x the command words)
+constexpr size_t kTableSlots = 512;
+
+constexpr size_t nameLength(const char* name) {
+    size_t length = 0;
+    while (name[length] != '\0') ++length;
+    return length;
+}
+
+constexpr size_t longestName() {
+    size_t longest = 0;
+    for (const auto& command : kCommands) {
+        longest = std::max(longest, nameLength(command.name));
+    }
+    return longest;
+}
+
+constexpr size_t kMaxNameLength = longestName();
+
+// FNV-1a with a tunable starting value
+constexpr uint32_t hashName(const char* name, size_t length, uint32_t seed) {
+    uint32_t hash = seed;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<uint8_t>(name[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Finds a seed for which every command word lands in its own slot
+ * Runs at compile time, which makes the command table a perfect hash.
+ */
+constexpr uint32_t findCommandSeed() {
+    for (uint32_t seed = 2166136261u;; ++seed) {
+        bool used[kTableSlots] = {};
+        bool collision = false;
+        for (const auto& command : kCommands) {
+            size_t slot = hashName(command.name, nameLength(command.name), seed) & (kTableSlots - 1);
+            if (used[slot]) {
+                collision = true;
+                break;
+            }
+            used[slot] = true;
+        }
+        if (!collision) return seed;
+    }
+}
+
+constexpr uint32_t kCommandSeed = findCommandSeed();
+
+struct SlotTable {
+    int8_t slots[kTableSlots];
+};
+
+// Command slot -> index into kCommands, -1 when empty
+constexpr SlotTable buildCommandTable() {
+    SlotTable table = {};
+    for (auto& slot : table.slots) slot = -1;
+    for (int i = 0; i < kCommandCount; ++i) {
+        const char* name = kCommands[i].name;
+        table.slots[hashName(name, nameLength(name), kCommandSeed) & (kTableSlots - 1)] = static_cast<int8_t>(i);
+    }
+    return table;
+}
+
+constexpr SlotTable kCommandTable = buildCommandTable();
+
+/**
+ * @brief Looks up a command word (any case), returning its kCommands index or -1
+ */
+int findCommand(const char* word, size_t length) {
+    // Command words are short, so an overlong input cannot match and skips hashing
+    char lower[kMaxNameLength];
+    if (length == 0 || length > kMaxNameLength) return -1;
+    for (size_t i = 0; i < length; ++i) {
+        lower[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(word[i])));
+    }
+    int index = kCommandTable.slots[hashName(lower, length, kCommandSeed) & (kTableSlots - 1)];
+    if (index < 0) return -1;
+    const char* candidate = kCommands[index].name;
+    return nameLength(candidate) == length && std::equal(lower, lower + length, candidate) ? index : -1;
+}
+
+// ============== Tokenizing ==============
+
+bool isSpace(char c) {
+    return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+/**
+ * @brief Appends the whitespace-separated words of input[pos, end) to tokens
+ */
+void appendTokens(const std::string& input, size_t pos, std::vector<std::string>& tokens) {
+    size_t length = input.size();
+    while (pos < length) {
+        while (pos < length && isSpace(input[pos])) ++pos;
+        size_t start = pos;
+        while (pos < length && !isSpace(input[pos])) ++pos;
+        if (pos > start) tokens.emplace_back(input, start, pos - start);
+    }
+}
+
+} // namespace
 
 std::vector<std::string> CommandParser::tokenize(const std::string& input) {
     std::vector<std::string> tokens;
-    std::stringstream ss(input);
-    std::string token;
-    
-    while (ss >> token) {
-        tokens.push_back(token);
-    }
-    
+    appendTokens(input, 0, tokens);
     return tokens;
 }
 
@@ -19,103 +227,33 @@ CommandParser::Command CommandParser::parse(const std::string& input) {
     Command cmd;
     cmd.type = INVALID;
     
-    std::string trimmedInput = Tokenizer::trim(input);
-    if (trimmedInput.empty()) {
+    // Find the command word without copying the line
+    size_t length = input.size();
+    size_t start = 0;
+    while (start < length && isSpace(input[start])) ++start;
+    if (start == length) {
         return cmd;
     }
+    size_t end = start;
+    while (end < length && !isSpace(input[end])) ++end;
+    
+    // Copy all arguments after the command
+    appendTokens(input, end, cmd.args);
     
-    std::vector<std::string> tokens = tokenize(trimmedInput);
-    if (tokens.empty()) {
+    int index = findCommand(input.data() + start, end - start);
+    if (index < 0) {
         return cmd;
     }
     
-    std::string commandStr = Tokenizer::toLower(tokens[0]);
-    
-    // Copy all arguments after the command
-    for (size_t i = 1; i < tokens.size(); ++i) {
-        cmd.args.push_back(tokens[i]);
+    const CommandSpec& spec = kCommands[index];
+    if (cmd.args.size() < spec.minArgs || cmd.args.size() > spec.maxArgs) {
+        return cmd;
     }
+    cmd.type = spec.type;
     
-    // Navigation commands
-    if (commandStr == "next" || commandStr == "n") {
-        cmd.type = NEXT;
-    } else if (commandStr == "prev" || commandStr == "p" || commandStr == "previous") {
-        cmd.type = PREV;
-    } else if (commandStr == "show" || commandStr == "s") {
-        cmd.type = SHOW;
-    } else if (commandStr == "goto" || commandStr == "g") {
-        if (tokens.size() == 2) {
-            cmd.type = GOTO;
-        } else if (tokens.size() == 3) {
-            cmd.type = GOTO_FILE;
-            cmd.args[0] = normalizePath(cmd.args[0]);
-        }
-    } else if (commandStr == "nextfile" || commandStr == "nf") {
-        cmd.type = NEXTFILE;
-    } else if (commandStr == "prevfile" || commandStr == "pf") {
-        cmd.type = PREVFILE;
-    }
-    // Shape manipulation
-    else if (commandStr == "add" || commandStr == "a") {
-        cmd.type = ADD;
-    } else if (commandStr == "delete" || commandStr == "del" || commandStr == "remove" || commandStr == "rm") {
-        cmd.type = DELETE;
-    } else if (commandStr == "edit" || commandStr == "e" || commandStr == "modify") {
-        cmd.type = EDIT;
-    } else if (commandStr == "list" || commandStr == "ls" || commandStr == "l") {
-        cmd.type = LIST;
-    } else if (commandStr == "clear") {
-        cmd.type = CLEAR;
-    }
-    // Slide manipulation
-    else if (commandStr == "newslide" || commandStr == "ns" || commandStr == "addslide") {
-        cmd.type = NEWSLIDE;
-    } else if (commandStr == "delslide" || commandStr == "ds" || commandStr == "removeslide") {
-        cmd.type = DELSLIDE;
-    }
-    // View modes
-    else if (commandStr == "visual" || commandStr == "v" || commandStr == "view") {
-        cmd.type = VISUAL;
-    } else if (commandStr == "text" || commandStr == "t") {
-        cmd.type = TEXT;
-    }
-    // Export commands
-    else if (commandStr == "export" || commandStr == "exp") {
-        cmd.type = EXPORT;
-    } else if (commandStr == "exportall" || commandStr == "expall") {
-        cmd.type = EXPORT_ALL;
-    } else if (commandStr == "exportjson" || commandStr == "expjson" || commandStr == "json") {
-        cmd.type = EXPORT_JSON;
-    }
-    // Theme/appearance
-    else if (commandStr == "theme") {
-        cmd.type = THEME;
-    } else if (commandStr == "colors") {
-        cmd.type = COLORS;
-    } else if (commandStr == "shapes") {
-        cmd.type = SHAPES;
-    }
-    // File operations
-    else if (commandStr == "new") {
-        cmd.type = NEW;
-    } else if (commandStr == "save") {
-        cmd.type = SAVE;
-    } else if (commandStr == "saveas") {
-        cmd.type = SAVEAS;
-    }
-    // Undo/Redo commands
-    else if (commandStr == "undo" || commandStr == "u" || commandStr == "z") {
-        cmd.type = UNDO;
-    } else if (commandStr == "redo" || commandStr == "r" || commandStr == "y") {
-        cmd.type = REDO;
-    } else if (commandStr == "history" || commandStr == "hist") {
-        cmd.type = HISTORY;
-    }
-    // System commands
-    else if (commandStr == "help" || commandStr == "h" || commandStr == "?") {
-        cmd.type = HELP;
-    } else if (commandStr == "exit" || commandStr == "quit" || commandStr == "q") {
-        cmd.type = EXIT;
+    if (cmd.type == GOTO && cmd.args.size() == 2) {
+        cmd.type = GOTO_FILE;
+        cmd.args[0] = normalizePath(cmd.args[0]);
     }
     
     return cmd;
@@ -0,0 +1,317 @@
+#include "EditJournal.h"
+#include "FileSync.h"
+#include "Profiler.h"
+#include "Tracer.h"
+#include <filesystem>
+#include <fstream>
+#include <unordered_set>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+// "SSJRNL01", then the deck's size and modification time as little-endian 64-bit values
+constexpr char kMagic[] = "SSJRNL01";
+constexpr size_t kMagicSize = sizeof(kMagic) - 1;
+constexpr size_t kHeaderSize = kMagicSize + 16;
+
+// Record: op (1 byte), slide number (4), payload length (4), payload, CRC-32 of all before it (4)
+constexpr size_t kRecordHeaderSize = 9;
+constexpr size_t kChecksumSize = 4;
+
+void putU32(std::string& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void putU64(std::string& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+uint32_t getU32(const char* in) {
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; --i) {
+        value = (value << 8) | static_cast<unsigned char>(in[i]);
+    }
+    return value;
+}
+
+uint32_t crc32(const char* data, size_t length) {
+    static const std::vector<uint32_t> table = [] {
+        std::vector<uint32_t> entries(256);
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entries[i] = c;
+        }
+        return entries;
+    }();
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; ++i) {
+        crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+bool isKnownOp(char op) {
+    return op == static_cast<char>(EditJournal::Op::SetSlide)
+        || op == static_cast<char>(EditJournal::Op::InsertSlide)
+        || op == static_cast<char>(EditJournal::Op::RemoveSlide);
+}
+
+// ============== File Access ==============
+
+int openJournalFile(const std::string& path, bool truncate) {
+#ifdef _WIN32
+    int flags = _O_WRONLY | _O_CREAT | _O_BINARY | (truncate ? _O_TRUNC : 0);
+    return ::_open(path.c_str(), flags, _S_IREAD | _S_IWRITE);
+#else
+    int flags = O_WRONLY | O_CREAT | (truncate ? O_TRUNC : 0);
+    return ::open(path.c_str(), flags, 0644);
+#endif
+}
+
+bool writeAll(int fd, const char* data, size_t length) {
+    while (length > 0) {
+#ifdef _WIN32
+        int chunk = length > 0x40000000 ? 0x40000000 : static_cast<int>(length);
+        int written = ::_write(fd, data, static_cast<unsigned>(chunk));
+#else
+        ssize_t written = ::write(fd, data, length);
+#endif
+        if (written <= 0) {
+            return false;
+        }
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+/**
+ * @brief Cuts the file to the given size and positions writes at its end
+ */
+bool truncateFile(int fd, uint64_t size) {
+#ifdef _WIN32
+    return ::_chsize_s(fd, static_cast<__int64>(size)) == 0 && ::_lseeki64(fd, 0, SEEK_END) >= 0;
+#else
+    return ::ftruncate(fd, static_cast<off_t>(size)) == 0 && ::lseek(fd, 0, SEEK_END) >= 0;
+#endif
+}
+
+} // namespace
+
+EditJournal::EditJournal(const std::string& deckFilename)
+    : deckFilename(deckFilename), path(pathFor(deckFilename)), header(makeHeader()),
+      fd(-1), resumeSize(0), pendingCount(0), writeFailed(false) {
+}
+
+EditJournal::~EditJournal() {
+    commit();
+    closeFile();
+}
+
+std::string EditJournal::pathFor(const std::string& deckFilename) {
+    return deckFilename + ".journal";
+}
+
+void EditJournal::append(Op op, int slideNumber, std::string_view payload) {
+    size_t start = pending.size();
+    pending.push_back(static_cast<char>(op));
+    putU32(pending, static_cast<uint32_t>(slideNumber));
+    putU32(pending, static_cast<uint32_t>(payload.size()));
+    pending.append(payload.data(), payload.size());
+    putU32(pending, crc32(pending.data() + start, pending.size() - start));
+
+    // Group commit: one write and one fsync for every record that arrived meanwhile
+    auto now = std::chrono::steady_clock::now();
+    if (pendingCount++ == 0) {
+        firstPendingTime = now;
+    }
+    if (pending.size() >= kCommitBytes || now - firstPendingTime >= kCommitInterval) {
+        if (!commit()) {
+            writeFailed = true;
+        }
+    }
+}
+
+bool EditJournal::commit() {
+    if (pending.empty()) {
+        bool ok = !writeFailed;
+        writeFailed = false;
+        return ok;
+    }
+
+    SLIDESHOW_PROFILE_SCOPE(JOURNAL_COMMIT);
+    Tracer::Span span("io", "EditJournal::commit");
+    span.arg("records", static_cast<int64_t>(pendingCount));
+    span.arg("bytes", static_cast<int64_t>(pending.size()));
+
+    bool ok = (fd >= 0 || openFile())
+        && writeAll(fd, pending.data(), pending.size())
+        && FileSync::syncDescriptor(fd);
+    pending.clear();
+    pendingCount = 0;
+
+    ok = ok && !writeFailed;
+    writeFailed = false;
+    return ok;
+}
+
+void EditJournal::discard() {
+    pending.clear();
+    pendingCount = 0;
+    writeFailed = false;
+    closeFile();
+    resumeSize = 0;
+
+    std::error_code error;
+    std::filesystem::remove(path, error);
+}
+
+int EditJournal::replay(const std::function<bool(const Record&)>& apply) {
+    SLIDESHOW_PROFILE_SCOPE(JOURNAL_REPLAY);
+    resumeSize = 0;
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return 0;
+    }
+    std::string data(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    file.read(&data[0], static_cast<std::streamsize>(data.size()));
+    if (!file || data.compare(0, kHeaderSize, header) != 0) {
+        return -1;
+    }
+
+    // Collect the intact records; anything after a damaged one is a torn write
+    std::vector<Record> records;
+    std::vector<uint64_t> ends;
+    size_t pos = kHeaderSize;
+    while (data.size() - pos >= kRecordHeaderSize + kChecksumSize) {
+        const char* record = data.data() + pos;
+        size_t length = getU32(record + 5);
+        if (length > data.size() - pos - kRecordHeaderSize - kChecksumSize) {
+            break;
+        }
+        size_t checked = kRecordHeaderSize + length;
+        if (!isKnownOp(record[0]) || getU32(record + checked) != crc32(record, checked)) {
+            break;
+        }
+        records.push_back(Record{static_cast<Op>(record[0]), static_cast<int>(getU32(record + 1)),
+                                 std::string_view(record + kRecordHeaderSize, length)});
+        pos += checked + kChecksumSize;
+        ends.push_back(pos);
+    }
+
+    // A SetSlide is superseded by a later SetSlide of the same slide unless
+    // an insert or removal in between renumbers the slides
+    std::vector<bool> superseded(records.size(), false);
+    std::unordered_set<int> setLater;
+    for (size_t i = records.size(); i-- > 0;) {
+        if (records[i].op != Op::SetSlide) {
+            setLater.clear();
+        } else if (!setLater.insert(records[i].slideNumber).second) {
+            superseded[i] = true;
+        }
+    }
+
+    int applied = 0;
+    uint64_t validSize = kHeaderSize;
+    size_t failed = records.size();
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (!superseded[i]) {
+            if (!apply(records[i])) {
+                failed = i;
+                break;
+            }
+            ++applied;
+        }
+        validSize = ends[i];
+    }
+
+    // A slide whose newest SetSlide before the failure was skipped for one after it
+    // never got that content; apply it now so the deck matches the records kept
+    if (failed < records.size()) {
+        std::vector<size_t> missed;
+        std::unordered_set<int> seen;
+        for (size_t i = failed; i-- > 0 && records[i].op == Op::SetSlide;) {
+            if (seen.insert(records[i].slideNumber).second && superseded[i]) {
+                missed.push_back(i);
+            }
+        }
+        for (size_t j = missed.size(); j-- > 0;) {
+            size_t i = missed[j];
+            if (!apply(records[i])) {
+                validSize = i > 0 ? ends[i - 1] : kHeaderSize;
+                break;
+            }
+            ++applied;
+        }
+    }
+    resumeSize = validSize;
+    return applied;
+}
+
+// ============== File Lifecycle ==============
+
+bool EditJournal::openFile() {
+    // Continue a replayed journal, minus any torn tail; otherwise start afresh
+    bool resume = resumeSize > 0;
+    fd = openJournalFile(path, !resume);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = resume ? truncateFile(fd, resumeSize) : writeAll(fd, header.data(), header.size());
+    if (!ok) {
+        closeFile();
+        return false;
+    }
+    if (!resume) {
+        FileSync::syncParentDirectory(path);
+    }
+    return true;
+}
+
+void EditJournal::closeFile() {
+    if (fd < 0) {
+        return;
+    }
+#ifdef _WIN32
+    ::_close(fd);
+#else
+    ::close(fd);
+#endif
+    fd = -1;
+}
+
+std::string EditJournal::makeHeader() const {
+    std::error_code error;
+    uint64_t size = std::filesystem::file_size(deckFilename, error);
+    if (error) {
+        size = 0;
+    }
+    int64_t time = 0;
+    auto writeTime = std::filesystem::last_write_time(deckFilename, error);
+    if (!error) {
+        time = static_cast<int64_t>(writeTime.time_since_epoch().count());
+    }
+
+    std::string out(kMagic, kMagicSize);
+    putU64(out, size);
+    putU64(out, static_cast<uint64_t>(time));
+    return out;
+}
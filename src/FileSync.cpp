@@ -0,0 +1,51 @@
+#include "FileSync.h"
+#include <filesystem>
+
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+bool FileSync::syncDescriptor(int fd) {
+#ifdef _WIN32
+    return ::_commit(fd) == 0;
+#else
+    return ::fsync(fd) == 0;
+#endif
+}
+
+bool FileSync::syncFile(const std::string& path) {
+#ifdef _WIN32
+    int fd = ::_open(path.c_str(), _O_WRONLY | _O_BINARY);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = syncDescriptor(fd);
+    return ::_close(fd) == 0 && ok;
+#else
+    int fd = ::open(path.c_str(), O_WRONLY);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = syncDescriptor(fd);
+    return ::close(fd) == 0 && ok;
+#endif
+}
+
+bool FileSync::syncParentDirectory(const std::string& path) {
+#ifdef _WIN32
+    (void)path;
+    return true;
+#else
+    std::string directory = std::filesystem::path(path).parent_path().string();
+    int dirFd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+    if (dirFd < 0) {
+        return false;
+    }
+    bool ok = syncDescriptor(dirFd);
+    ::close(dirFd);
+    return ok;
+#endif
+}
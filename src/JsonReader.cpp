@@ -0,0 +1,319 @@
+#include "JsonReader.h"
+#include <charconv>
+
+namespace {
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * @brief Reads the four hex digits of a \u escape
+ */
+bool readHex4(std::string_view input, size_t& pos, unsigned& code) {
+    if (input.size() - pos < 4) {
+        return false;
+    }
+    code = 0;
+    for (int i = 0; i < 4; ++i) {
+        int digit = hexValue(input[pos++]);
+        if (digit < 0) {
+            return false;
+        }
+        code = code * 16 + static_cast<unsigned>(digit);
+    }
+    return true;
+}
+
+void appendUtf8(std::string& out, unsigned code) {
+    if (code < 0x80) {
+        out.push_back(static_cast<char>(code));
+    } else if (code < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else if (code < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+}
+
+} // namespace
+
+bool JsonReader::parse(std::string_view text, Handler& handler) {
+    input = text;
+    pos = 0;
+    containers.clear();
+    error.clear();
+
+    if (!parseValue(handler)) {
+        return false;
+    }
+
+    // Each pass reads one member or element of the innermost open container
+    bool justOpened = !containers.empty();
+    while (!containers.empty()) {
+        skipWhitespace();
+        if (pos >= input.size()) {
+            return fail("unexpected end of input");
+        }
+
+        bool inObject = containers.back() == '{';
+        if (input[pos] == (inObject ? '}' : ']')) {
+            if (!closeContainer(handler)) {
+                return false;
+            }
+            justOpened = false;
+            continue;
+        }
+
+        if (!justOpened) {
+            if (input[pos] != ',') {
+                return fail(inObject ? "expected ',' or '}'" : "expected ',' or ']'");
+            }
+            ++pos;
+        }
+
+        size_t depth = containers.size();
+        if (inObject && !parseKey(handler)) {
+            return false;
+        }
+        if (!parseValue(handler)) {
+            return false;
+        }
+        justOpened = containers.size() > depth;
+    }
+
+    skipWhitespace();
+    if (pos != input.size()) {
+        return fail("unexpected text after the document");
+    }
+    return true;
+}
+
+void JsonReader::skipWhitespace() {
+    while (pos < input.size()) {
+        char c = input[pos];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+            return;
+        }
+        ++pos;
+    }
+}
+
+bool JsonReader::parseValue(Handler& handler) {
+    skipWhitespace();
+    if (pos >= input.size()) {
+        return fail("unexpected end of input");
+    }
+
+    switch (input[pos]) {
+        case '{':
+            ++pos;
+            containers.push_back('{');
+            return handler.beginObject() || stopped();
+        case '[':
+            ++pos;
+            containers.push_back('[');
+            return handler.beginArray() || stopped();
+        case '"': {
+            std::string_view text;
+            return parseString(text) && (handler.string(text) || stopped());
+        }
+        case 't':
+            return parseLiteral("true") && (handler.boolean(true) || stopped());
+        case 'f':
+            return parseLiteral("false") && (handler.boolean(false) || stopped());
+        case 'n':
+            return parseLiteral("null") && (handler.null() || stopped());
+        default:
+            return parseNumber(handler);
+    }
+}
+
+bool JsonReader::parseKey(Handler& handler) {
+    skipWhitespace();
+    if (pos >= input.size() || input[pos] != '"') {
+        return fail("expected a member name");
+    }
+
+    std::string_view name;
+    if (!parseString(name)) {
+        return false;
+    }
+
+    skipWhitespace();
+    if (pos >= input.size() || input[pos] != ':') {
+        return fail("expected ':'");
+    }
+    ++pos;
+    return handler.key(name) || stopped();
+}
+
+bool JsonReader::parseString(std::string_view& text) {
+    size_t start = ++pos;
+
+    // Fast path: no escapes, so the string is a view into the input
+    while (pos < input.size()) {
+        char c = input[pos];
+        if (c == '"') {
+            text = input.substr(start, pos - start);
+            ++pos;
+            return true;
+        }
+        if (c == '\\') {
+            break;
+        }
+        if (static_cast<unsigned char>(c) < 0x20) {
+            return fail("control character in string");
+        }
+        ++pos;
+    }
+
+    scratch.assign(input.data() + start, pos - start);
+    while (pos < input.size()) {
+        char c = input[pos];
+        if (c == '"') {
+            ++pos;
+            text = scratch;
+            return true;
+        }
+        if (static_cast<unsigned char>(c) < 0x20) {
+            return fail("control character in string");
+        }
+        ++pos;
+        if (c != '\\') {
+            scratch.push_back(c);
+            continue;
+        }
+
+        if (pos >= input.size()) {
+            break;
+        }
+        char escape = input[pos++];
+        switch (escape) {
+            case '"':
+            case '\\':
+            case '/': scratch.push_back(escape); break;
+            case 'b': scratch.push_back('\b'); break;
+            case 'f': scratch.push_back('\f'); break;
+            case 'n': scratch.push_back('\n'); break;
+            case 'r': scratch.push_back('\r'); break;
+            case 't': scratch.push_back('\t'); break;
+            case 'u': {
+                unsigned code = 0;
+                if (!readHex4(input, pos, code)) {
+                    return fail("invalid \\u escape");
+                }
+                if (code >= 0xD800 && code < 0xDC00) {
+                    // A high surrogate must be followed by an escaped low surrogate
+                    unsigned low = 0;
+                    bool paired = input.substr(pos, 2) == "\\u";
+                    if (paired) {
+                        pos += 2;
+                        paired = readHex4(input, pos, low) && low >= 0xDC00 && low <= 0xDFFF;
+                    }
+                    if (!paired) {
+                        return fail("unpaired surrogate in \\u escape");
+                    }
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                } else if (code >= 0xDC00 && code <= 0xDFFF) {
+                    return fail("unpaired surrogate in \\u escape");
+                }
+                appendUtf8(scratch, code);
+                break;
+            }
+            default:
+                --pos;
+                return fail("invalid escape in string");
+        }
+    }
+    return fail("unterminated string");
+}
+
+bool JsonReader::parseLiteral(std::string_view literal) {
+    if (input.substr(pos, literal.size()) != literal) {
+        return fail("expected a value");
+    }
+    pos += literal.size();
+    return true;
+}
+
+bool JsonReader::parseNumber(Handler& handler) {
+    // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+    size_t start = pos;
+    if (input[pos] == '-') {
+        ++pos;
+    }
+    if (pos >= input.size() || !isDigit(input[pos])) {
+        return fail(pos == start ? "expected a value" : "invalid number");
+    }
+    if (input[pos] == '0') {
+        ++pos;
+    } else {
+        while (pos < input.size() && isDigit(input[pos])) ++pos;
+    }
+    if (pos < input.size() && input[pos] == '.') {
+        ++pos;
+        if (pos >= input.size() || !isDigit(input[pos])) {
+            return fail("invalid number");
+        }
+        while (pos < input.size() && isDigit(input[pos])) ++pos;
+    }
+    if (pos < input.size() && (input[pos] == 'e' || input[pos] == 'E')) {
+        ++pos;
+        if (pos < input.size() && (input[pos] == '+' || input[pos] == '-')) {
+            ++pos;
+        }
+        if (pos >= input.size() || !isDigit(input[pos])) {
+            return fail("invalid number");
+        }
+        while (pos < input.size() && isDigit(input[pos])) ++pos;
+    }
+
+    double value = 0.0;
+    auto result = std::from_chars(input.data() + start, input.data() + pos, value);
+    if (result.ec != std::errc()) {
+        pos = start;
+        return fail("number out of range");
+    }
+    return handler.number(value) || stopped();
+}
+
+bool JsonReader::closeContainer(Handler& handler) {
+    char bracket = containers.back();
+    containers.pop_back();
+    ++pos;
+    bool keepGoing = bracket == '{' ? handler.endObject() : handler.endArray();
+    return keepGoing || stopped();
+}
+
+bool JsonReader::fail(const char* message) {
+    size_t line = 1;
+    size_t lineStart = 0;
+    size_t end = pos < input.size() ? pos : input.size();
+    for (size_t i = 0; i < end; ++i) {
+        if (input[i] == '\n') {
+            ++line;
+            lineStart = i + 1;
+        }
+    }
+    error = "line " + std::to_string(line) + ", column " + std::to_string(end - lineStart + 1) + ": " + message;
+    return false;
+}
+
+bool JsonReader::stopped() {
+    return fail("stopped by the handler");
+}
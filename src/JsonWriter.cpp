@@ -0,0 +1,145 @@
+#include "JsonWriter.h"
+#include <cmath>
+
+void JsonWriter::beginObject() {
+    openContainer('{');
+}
+
+void JsonWriter::endObject() {
+    closeContainer('}');
+}
+
+void JsonWriter::beginArray() {
+    openContainer('[');
+}
+
+void JsonWriter::endArray() {
+    closeContainer(']');
+}
+
+void JsonWriter::value(int64_t number) {
+    beginValue();
+    writeInt(number);
+}
+
+void JsonWriter::value(double number) {
+    beginValue();
+    if (std::isfinite(number)) {
+        writeDouble(number);
+    } else {
+        write("null");
+    }
+}
+
+void JsonWriter::value(bool flag) {
+    beginValue();
+    if (flag) {
+        write("true");
+    } else {
+        write("false");
+    }
+}
+
+void JsonWriter::value(const std::string& text) {
+    beginValue();
+    write('"');
+    writeEscaped(text.data(), text.size());
+    write('"');
+}
+
+void JsonWriter::value(const char* text) {
+    beginValue();
+    write('"');
+    writeEscaped(text, std::char_traits<char>::length(text));
+    write('"');
+}
+
+void JsonWriter::reset() {
+    hasItems.clear();
+    afterKey = false;
+}
+
+// ============== Layout ==============
+
+void JsonWriter::beginValue() {
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    if (hasItems.empty()) {
+        return;
+    }
+    if (hasItems.back()) {
+        write(',');
+    }
+    hasItems.back() = true;
+    newline();
+}
+
+void JsonWriter::endKey() {
+    if (pretty) {
+        write("\": ");
+    } else {
+        write("\":");
+    }
+    afterKey = true;
+}
+
+void JsonWriter::openContainer(char bracket) {
+    beginValue();
+    write(bracket);
+    hasItems.push_back(false);
+}
+
+void JsonWriter::closeContainer(char bracket) {
+    if (hasItems.empty()) {
+        return;
+    }
+    bool hadItems = hasItems.back();
+    hasItems.pop_back();
+    if (hadItems) {
+        newline();
+    }
+    write(bracket);
+}
+
+void JsonWriter::newline() {
+    if (!pretty) {
+        return;
+    }
+    static const char kIndent[] = "\n                                ";
+    const size_t kMaxRun = sizeof(kIndent) - 2;
+    size_t indent = hasItems.size() * 2;
+    size_t run = indent < kMaxRun ? indent : kMaxRun;
+    write(kIndent, run + 1);
+    for (indent -= run; indent > 0; indent -= run) {
+        run = indent < kMaxRun ? indent : kMaxRun;
+        write(kIndent + 1, run);
+    }
+}
+
+void JsonWriter::writeEscaped(const char* text, size_t length) {
+    static const char kHex[] = "0123456789abcdef";
+    size_t start = 0;
+    for (size_t i = 0; i < length; ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        write(text + start, i - start);
+        start = i + 1;
+        switch (c) {
+            case '"':  write("\\\""); break;
+            case '\\': write("\\\\"); break;
+            case '\n': write("\\n"); break;
+            case '\r': write("\\r"); break;
+            case '\t': write("\\t"); break;
+            default: {
+                char escape[] = {'\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xF]};
+                write(escape, sizeof(escape));
+                break;
+            }
+        }
+    }
+    write(text + start, length - start);
+}
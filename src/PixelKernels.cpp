@@ -0,0 +1,346 @@
+#include "PixelKernels.h"
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PIXELKERNELS_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#else
+#define PIXELKERNELS_X86 0
+#endif
+
+// GCC and Clang compile each SIMD function for its own target so the rest of
+// the program does not need -mavx2; MSVC accepts the intrinsics as is.
+#if defined(__GNUC__) || defined(__clang__)
+#define PIXELKERNELS_TARGET(isa) __attribute__((target(isa)))
+#else
+#define PIXELKERNELS_TARGET(isa)
+#endif
+
+static_assert(sizeof(Color) == 4, "Color must be four packed bytes for the pixel kernels");
+
+namespace {
+
+// ============== Scalar Kernels ==============
+
+void fillScalar(Color* dst, size_t count, const Color& color) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = color;
+    }
+}
+
+void rgbToBgrScalar(const Color* src, uint8_t* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i * 3 + 0] = src[i].b;
+        dst[i * 3 + 1] = src[i].g;
+        dst[i * 3 + 2] = src[i].r;
+    }
+}
+
+// round((s * a + d * (255 - a)) / 255), exact for all inputs
+inline uint8_t blendChannel(uint8_t s, uint8_t d, uint8_t a) {
+    unsigned v = s * a + d * (255u - a) + 128u;
+    return static_cast<uint8_t>((v + (v >> 8)) >> 8);
+}
+
+// The source counts as opaque, so an opaque destination stays opaque
+inline void blendScalarPixel(Color& dst, const Color& color, uint8_t a) {
+    dst.r = blendChannel(color.r, dst.r, a);
+    dst.g = blendChannel(color.g, dst.g, a);
+    dst.b = blendChannel(color.b, dst.b, a);
+    dst.a = blendChannel(255, dst.a, a);
+}
+
+void blendCoverageScalar(Color* dst, const uint8_t* alpha, size_t count, const Color& color) {
+    for (size_t i = 0; i < count; ++i) {
+        if (alpha[i] != 0) {
+            blendScalarPixel(dst[i], color, alpha[i]);
+        }
+    }
+}
+
+void blendSolidScalar(Color* dst, size_t count, const Color& color) {
+    if (color.a == 0) return;
+    for (size_t i = 0; i < count; ++i) {
+        blendScalarPixel(dst[i], color, color.a);
+    }
+}
+
+#if PIXELKERNELS_X86
+
+inline int32_t packPixel(const Color& color) {
+    int32_t packed;
+    std::memcpy(&packed, &color, sizeof(packed));
+    return packed;
+}
+
+// ============== SSSE3 Kernels ==============
+
+PIXELKERNELS_TARGET("ssse3")
+void fillSSSE3(Color* dst, size_t count, const Color& color) {
+    __m128i pixel = _mm_set1_epi32(packPixel(color));
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), pixel);
+    }
+    fillScalar(dst + i, count - i, color);
+}
+
+PIXELKERNELS_TARGET("ssse3")
+void rgbToBgrSSSE3(const Color* src, uint8_t* dst, size_t count) {
+    // Four pixels in, twelve bytes out; the last four lanes are zeroed
+    const __m128i mask = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    size_t i = 0;
+    // Each store writes 16 bytes, so keep two spare pixels in range for the
+    // overhang (the next step overwrites it)
+    for (; i + 6 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 3), _mm_shuffle_epi8(v, mask));
+    }
+    rgbToBgrScalar(src + i, dst + i * 3, count - i);
+}
+
+// Blends 16 bytes: (s * a + d * (255 - a) + 128) / 255 in 16-bit lanes
+PIXELKERNELS_TARGET("ssse3")
+inline __m128i blend16(__m128i d, __m128i s, __m128i a) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i c255 = _mm_set1_epi16(255);
+    const __m128i c128 = _mm_set1_epi16(128);
+    
+    __m128i dLo = _mm_unpacklo_epi8(d, zero), dHi = _mm_unpackhi_epi8(d, zero);
+    __m128i sLo = _mm_unpacklo_epi8(s, zero), sHi = _mm_unpackhi_epi8(s, zero);
+    __m128i aLo = _mm_unpacklo_epi8(a, zero), aHi = _mm_unpackhi_epi8(a, zero);
+    
+    __m128i vLo = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(sLo, aLo),
+                                              _mm_mullo_epi16(dLo, _mm_sub_epi16(c255, aLo))), c128);
+    __m128i vHi = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(sHi, aHi),
+                                              _mm_mullo_epi16(dHi, _mm_sub_epi16(c255, aHi))), c128);
+    vLo = _mm_srli_epi16(_mm_add_epi16(vLo, _mm_srli_epi16(vLo, 8)), 8);
+    vHi = _mm_srli_epi16(_mm_add_epi16(vHi, _mm_srli_epi16(vHi, 8)), 8);
+    return _mm_packus_epi16(vLo, vHi);
+}
+
+PIXELKERNELS_TARGET("ssse3")
+void blendCoverageSSSE3(Color* dst, const uint8_t* alpha, size_t count, const Color& color) {
+    __m128i s = _mm_set1_epi32(packPixel(color.withAlpha(255)));
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        int32_t group;
+        std::memcpy(&group, alpha + i, sizeof(group));
+        // Untouched and fully covered groups need no arithmetic
+        if (group == 0) continue;
+        __m128i* p = reinterpret_cast<__m128i*>(dst + i);
+        if (group == -1) {
+            _mm_storeu_si128(p, s);
+            continue;
+        }
+        // Repeat each pixel's alpha over its four channels
+        __m128i a = _mm_cvtsi32_si128(group);
+        a = _mm_unpacklo_epi8(a, a);
+        a = _mm_unpacklo_epi16(a, a);
+        _mm_storeu_si128(p, blend16(_mm_loadu_si128(p), s, a));
+    }
+    blendCoverageScalar(dst + i, alpha + i, count - i, color);
+}
+
+PIXELKERNELS_TARGET("ssse3")
+void blendSolidSSSE3(Color* dst, size_t count, const Color& color) {
+    if (color.a == 0) return;
+    __m128i s = _mm_set1_epi32(packPixel(color.withAlpha(255)));
+    __m128i a = _mm_set1_epi8(static_cast<char>(color.a));
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i* p = reinterpret_cast<__m128i*>(dst + i);
+        _mm_storeu_si128(p, blend16(_mm_loadu_si128(p), s, a));
+    }
+    blendSolidScalar(dst + i, count - i, color);
+}
+
+// ============== AVX2 Kernels ==============
+
+PIXELKERNELS_TARGET("avx2")
+void fillAVX2(Color* dst, size_t count, const Color& color) {
+    __m256i pixel = _mm256_set1_epi32(packPixel(color));
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), pixel);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 8), pixel);
+    }
+    fillSSSE3(dst + i, count - i, color);
+}
+
+PIXELKERNELS_TARGET("avx2")
+void rgbToBgrAVX2(const Color* src, uint8_t* dst, size_t count) {
+    // The shuffle packs twelve bytes at the start of each 128-bit lane; the
+    // permute then closes the gap so all 24 bytes are contiguous
+    const __m256i mask = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i gather = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+    size_t i = 0;
+    for (; i + 11 <= count; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        v = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(v, mask), gather);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 3), v);
+    }
+    rgbToBgrSSSE3(src + i, dst + i * 3, count - i);
+}
+
+// Same arithmetic as blend16 on 32 bytes; unpack and pack both stay within
+// 128-bit lanes, so the pixel order is preserved
+PIXELKERNELS_TARGET("avx2")
+inline __m256i blend32(__m256i d, __m256i s, __m256i a) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i c255 = _mm256_set1_epi16(255);
+    const __m256i c128 = _mm256_set1_epi16(128);
+    
+    __m256i dLo = _mm256_unpacklo_epi8(d, zero), dHi = _mm256_unpackhi_epi8(d, zero);
+    __m256i sLo = _mm256_unpacklo_epi8(s, zero), sHi = _mm256_unpackhi_epi8(s, zero);
+    __m256i aLo = _mm256_unpacklo_epi8(a, zero), aHi = _mm256_unpackhi_epi8(a, zero);
+    
+    __m256i vLo = _mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(sLo, aLo),
+                                                    _mm256_mullo_epi16(dLo, _mm256_sub_epi16(c255, aLo))), c128);
+    __m256i vHi = _mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(sHi, aHi),
+                                                    _mm256_mullo_epi16(dHi, _mm256_sub_epi16(c255, aHi))), c128);
+    vLo = _mm256_srli_epi16(_mm256_add_epi16(vLo, _mm256_srli_epi16(vLo, 8)), 8);
+    vHi = _mm256_srli_epi16(_mm256_add_epi16(vHi, _mm256_srli_epi16(vHi, 8)), 8);
+    return _mm256_packus_epi16(vLo, vHi);
+}
+
+PIXELKERNELS_TARGET("avx2")
+void blendCoverageAVX2(Color* dst, const uint8_t* alpha, size_t count, const Color& color) {
+    __m256i s = _mm256_set1_epi32(packPixel(color.withAlpha(255)));
+    const __m256i spread = _mm256_set1_epi32(0x01010101);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        int64_t group;
+        std::memcpy(&group, alpha + i, sizeof(group));
+        if (group == 0) continue;
+        __m256i* p = reinterpret_cast<__m256i*>(dst + i);
+        if (group == -1) {
+            _mm256_storeu_si256(p, s);
+            continue;
+        }
+        // Widen each alpha to 32 bits, then copy it into all four bytes
+        __m256i a = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(alpha + i)));
+        a = _mm256_mullo_epi32(a, spread);
+        _mm256_storeu_si256(p, blend32(_mm256_loadu_si256(p), s, a));
+    }
+    blendCoverageSSSE3(dst + i, alpha + i, count - i, color);
+}
+
+PIXELKERNELS_TARGET("avx2")
+void blendSolidAVX2(Color* dst, size_t count, const Color& color) {
+    if (color.a == 0) return;
+    __m256i s = _mm256_set1_epi32(packPixel(color.withAlpha(255)));
+    __m256i a = _mm256_set1_epi8(static_cast<char>(color.a));
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i* p = reinterpret_cast<__m256i*>(dst + i);
+        _mm256_storeu_si256(p, blend32(_mm256_loadu_si256(p), s, a));
+    }
+    blendSolidSSSE3(dst + i, count - i, color);
+}
+
+#endif // PIXELKERNELS_X86
+
+// ============== Dispatch ==============
+
+struct KernelTable {
+    PixelKernels::Level level;
+    void (*fill)(Color*, size_t, const Color&);
+    void (*rgbToBgr)(const Color*, uint8_t*, size_t);
+    void (*blendCoverage)(Color*, const uint8_t*, size_t, const Color&);
+    void (*blendSolid)(Color*, size_t, const Color&);
+};
+
+KernelTable makeTable(PixelKernels::Level level) {
+#if PIXELKERNELS_X86
+    if (level == PixelKernels::AVX2) {
+        return {level, fillAVX2, rgbToBgrAVX2, blendCoverageAVX2, blendSolidAVX2};
+    }
+    if (level == PixelKernels::SSSE3) {
+        return {level, fillSSSE3, rgbToBgrSSSE3, blendCoverageSSSE3, blendSolidSSSE3};
+    }
+#endif
+    return {PixelKernels::SCALAR, fillScalar, rgbToBgrScalar, blendCoverageScalar, blendSolidScalar};
+}
+
+const KernelTable* tableFor(PixelKernels::Level level) {
+    static const KernelTable tables[] = {
+        makeTable(PixelKernels::SCALAR),
+        makeTable(PixelKernels::SSSE3),
+        makeTable(PixelKernels::AVX2)
+    };
+    return &tables[level];
+}
+
+// The tables never change; setLevel() swaps the active one with a single
+// atomic store, so a thread rendering meanwhile calls through one whole table
+std::atomic<const KernelTable*>& activeTable() {
+    static std::atomic<const KernelTable*> table{tableFor(PixelKernels::detectLevel())};
+    return table;
+}
+
+const KernelTable& getTable() {
+    return *activeTable().load(std::memory_order_acquire);
+}
+
+} // namespace
+
+void PixelKernels::fill(Color* dst, size_t count, const Color& color) {
+    getTable().fill(dst, count, color);
+}
+
+void PixelKernels::rgbToBgr(const Color* src, uint8_t* dst, size_t count) {
+    getTable().rgbToBgr(src, dst, count);
+}
+
+void PixelKernels::blendCoverage(Color* dst, const uint8_t* alpha, size_t count, const Color& color) {
+    getTable().blendCoverage(dst, alpha, count, color);
+}
+
+void PixelKernels::blendSolid(Color* dst, size_t count, const Color& color) {
+    getTable().blendSolid(dst, count, color);
+}
+
+PixelKernels::Level PixelKernels::getLevel() {
+    return getTable().level;
+}
+
+bool PixelKernels::setLevel(Level level) {
+    if (level > detectLevel()) {
+        return false;
+    }
+    activeTable().store(tableFor(level), std::memory_order_release);
+    return true;
+}
+
+PixelKernels::Level PixelKernels::detectLevel() {
+#if PIXELKERNELS_X86 && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return AVX2;
+    if (__builtin_cpu_supports("ssse3")) return SSSE3;
+#elif PIXELKERNELS_X86 && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    bool ssse3 = (info[2] & (1 << 9)) != 0;
+    bool osAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 &&
+                 (_xgetbv(0) & 0x6) == 0x6;
+    __cpuidex(info, 7, 0);
+    bool avx2 = (info[1] & (1 << 5)) != 0;
+    if (osAvx && avx2) return AVX2;
+    if (ssse3) return SSSE3;
+#endif
+    return SCALAR;
+}
+
+const char* PixelKernels::getLevelName(Level level) {
+    switch (level) {
+        case AVX2: return "AVX2";
+        case SSSE3: return "SSSE3";
+        default: return "Scalar";
+    }
+}
@@ -0,0 +1,190 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+// Samples kept per operation for percentiles; later calls replace random entries
+constexpr size_t kMaxSamples = 1 << 16;
+
+constexpr const char* kOperationNames[Profiler::OPERATION_COUNT] = {
+    "load",
+    "save",
+    "journal.commit",
+    "journal.replay",
+    "slide.render",
+    "canvas.fillRect",
+    "canvas.drawRect",
+    "canvas.fillCircle",
+    "canvas.drawCircle",
+    "canvas.fillEllipse",
+    "canvas.drawEllipse",
+    "canvas.drawLine",
+    "canvas.fillTriangle",
+    "canvas.fillPolygon",
+    "canvas.drawPolygon",
+    "export.bmp",
+    "export.svg",
+    "export.json",
+    "undo.saveState",
+    "undo.undo",
+    "undo.redo"
+};
+
+struct OperationData {
+    std::mutex mutex;
+    uint64_t count = 0;
+    uint64_t totalNs = 0;
+    uint64_t minNs = 0;
+    uint64_t maxNs = 0;
+    std::vector<uint64_t> samples;
+    uint64_t randomState = 0x9E3779B97F4A7C15ull;
+
+    // Reservoir sampling keeps a uniform sample of all calls in bounded memory
+    void add(uint64_t ns) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (count == 0 || ns < minNs) minNs = ns;
+        if (ns > maxNs) maxNs = ns;
+        ++count;
+        totalNs += ns;
+        if (samples.size() < kMaxSamples) {
+            samples.push_back(ns);
+            return;
+        }
+        randomState = randomState * 6364136223846793005ull + 1442695040888963407ull;
+        uint64_t slot = (randomState >> 11) % count;
+        if (slot < kMaxSamples) {
+            samples[slot] = ns;
+        }
+    }
+};
+
+std::atomic<bool> profilingEnabled(false);
+OperationData operationData[Profiler::OPERATION_COUNT];
+
+uint64_t percentile(std::vector<uint64_t>& sorted, double fraction) {
+    size_t index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+std::string formatNs(uint64_t ns) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    if (ns >= 1000000000ull) {
+        out << ns / 1e9 << " s";
+    } else if (ns >= 1000000ull) {
+        out << ns / 1e6 << " ms";
+    } else if (ns >= 1000ull) {
+        out << ns / 1e3 << " us";
+    } else {
+        out << ns << " ns";
+    }
+    return out.str();
+}
+
+} // namespace
+
+void Profiler::setEnabled(bool enabled) {
+    profilingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Profiler::isEnabled() {
+    return profilingEnabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::record(Operation op, uint64_t nanoseconds) {
+    if (op < 0 || op >= OPERATION_COUNT) return;
+    operationData[op].add(nanoseconds);
+}
+
+Profiler::Stats Profiler::getStats(Operation op) {
+    Stats stats;
+    if (op < 0 || op >= OPERATION_COUNT) return stats;
+
+    std::vector<uint64_t> samples;
+    {
+        OperationData& data = operationData[op];
+        std::lock_guard<std::mutex> lock(data.mutex);
+        stats.count = data.count;
+        stats.totalNs = data.totalNs;
+        stats.minNs = data.minNs;
+        stats.maxNs = data.maxNs;
+        samples = data.samples;
+    }
+
+    if (!samples.empty()) {
+        std::sort(samples.begin(), samples.end());
+        stats.p50Ns = percentile(samples, 0.50);
+        stats.p90Ns = percentile(samples, 0.90);
+        stats.p99Ns = percentile(samples, 0.99);
+    }
+    return stats;
+}
+
+void Profiler::reset() {
+    for (OperationData& data : operationData) {
+        std::lock_guard<std::mutex> lock(data.mutex);
+        data.count = 0;
+        data.totalNs = 0;
+        data.minNs = 0;
+        data.maxNs = 0;
+        data.samples.clear();
+    }
+}
+
+const char* Profiler::getOperationName(Operation op) {
+    if (op < 0 || op >= OPERATION_COUNT) return "unknown";
+    return kOperationNames[op];
+}
+
+std::string Profiler::report() {
+    std::ostringstream out;
+    out << std::left << std::setw(22) << "  Operation"
+        << std::right << std::setw(10) << "Count"
+        << std::setw(12) << "Total"
+        << std::setw(12) << "Mean"
+        << std::setw(12) << "p50"
+        << std::setw(12) << "p90"
+        << std::setw(12) << "p99"
+        << std::setw(12) << "Max" << "\n";
+
+    bool any = false;
+    for (int i = 0; i < OPERATION_COUNT; ++i) {
+        Stats stats = getStats(static_cast<Operation>(i));
+        if (stats.count == 0) continue;
+        any = true;
+        out << std::left << std::setw(22) << (std::string("  ") + kOperationNames[i])
+            << std::right << std::setw(10) << stats.count
+            << std::setw(12) << formatNs(stats.totalNs)
+            << std::setw(12) << formatNs(stats.totalNs / stats.count)
+            << std::setw(12) << formatNs(stats.p50Ns)
+            << std::setw(12) << formatNs(stats.p90Ns)
+            << std::setw(12) << formatNs(stats.p99Ns)
+            << std::setw(12) << formatNs(stats.maxNs) << "\n";
+    }
+    if (!any) {
+        out << "  (nothing recorded)\n";
+    }
+    return out.str();
+}
+
+bool Profiler::dumpToFile(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << "operation,count,total_ns,mean_ns,min_ns,p50_ns,p90_ns,p99_ns,max_ns\n";
+    for (int i = 0; i < OPERATION_COUNT; ++i) {
+        Stats stats = getStats(static_cast<Operation>(i));
+        file << kOperationNames[i] << ',' << stats.count << ',' << stats.totalNs << ','
+             << (stats.count > 0 ? stats.totalNs / stats.count : 0) << ',' << stats.minNs << ','
+             << stats.p50Ns << ',' << stats.p90Ns << ',' << stats.p99Ns << ',' << stats.maxNs << '\n';
+    }
+    return file.good();
+}
@@ -1,12 +1,114 @@
 #include "Shape.h"
 #include "Canvas.h"
+#include "JsonWriter.h"
+#include "SvgWriter.h"
+#include <algorithm>
 #include <iostream>
-#include <sstream>
 #include <cmath>
+#include <cstddef>
+
+namespace {
+
+/**
+ * @brief A vertex on the unit circle, stored as (cos, sin) of its angle
+ */
+struct UnitVertex {
+    double c;
+    double s;
+};
+
+// Unit vertex tables for the regular shapes. The literals are the exact values
+// std::cos/std::sin produce for each angle, so the truncated pixel vertices
+// (and every BMP/SVG export) match what runtime evaluation used to give.
+
+// Star: angle = PI/2 + i * PI/5, even indices are outer points
+constexpr UnitVertex kStarUnit[10] = {
+    {6.123233995736766e-17, 1.0},
+    {-0.58778525229247303, 0.80901699437494745},
+    {-0.95105651629515353, 0.30901699437494751},
+    {-0.95105651629515364, -0.30901699437494728},
+    {-0.58778525229247325, -0.80901699437494734},
+    {-1.8369701987210297e-16, -1.0},
+    {0.58778525229247292, -0.80901699437494756},
+    {0.95105651629515353, -0.30901699437494762},
+    {0.95105651629515364, 0.30901699437494717},
+    {0.58778525229247336, 0.80901699437494723}
+};
+
+// Hexagon: angle = i * PI/3
+constexpr UnitVertex kHexagonUnit[6] = {
+    {1.0, 0.0},
+    {0.50000000000000011, 0.8660254037844386},
+    {-0.49999999999999978, 0.86602540378443871},
+    {-1.0, 1.2246467991473532e-16},
+    {-0.50000000000000044, -0.86602540378443837},
+    {0.50000000000000011, -0.8660254037844386}
+};
+
+// Pentagon: angle = PI/2 + i * 2PI/5
+constexpr UnitVertex kPentagonUnit[5] = {
+    {6.123233995736766e-17, 1.0},
+    {-0.95105651629515353, 0.30901699437494751},
+    {-0.58778525229247325, -0.80901699437494734},
+    {0.58778525229247292, -0.80901699437494756},
+    {0.95105651629515364, 0.30901699437494717}
+};
+
+/**
+ * @brief Scales a unit table around (cx, cy)
+ * Even entries use outerR and odd entries innerR; ySign flips the y axis
+ * for shapes that are drawn point-up.
+ */
+template <std::size_t N>
+void buildRegularVertices(std::vector<std::pair<int, int>>& out, const UnitVertex (&unit)[N],
+                          int cx, int cy, int outerR, int innerR, int ySign) {
+    out.clear();
+    out.reserve(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        int r = (i % 2 == 0) ? outerR : innerR;
+        out.push_back({
+            cx + static_cast<int>(r * unit[i].c),
+            cy + ySign * static_cast<int>(r * unit[i].s)
+        });
+    }
+}
+
+/**
+ * @brief Writes a color as {"name", "r", "g", "b"}, plus "a" when translucent
+ */
+void writeColorJSON(JsonWriter& out, const Color& color) {
+    out.beginObject();
+    out.member("name", color.getName());
+    out.member("r", static_cast<int>(color.r));
+    out.member("g", static_cast<int>(color.g));
+    out.member("b", static_cast<int>(color.b));
+    if (!color.isOpaque()) {
+        out.member("a", static_cast<int>(color.a));
+    }
+    out.endObject();
+}
 
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
+// Far beyond any canvas, yet small enough that rendering the shape stays cheap
+constexpr double kMaxScaled = 1 << 16;
+
+/**
+ * @brief Rounds a scaled value, clamped so std::lround stays in range
+ */
+int roundScaled(double value) {
+    return static_cast<int>(std::lround(std::clamp(value, -kMaxScaled, kMaxScaled)));
+}
+
+int scaleAbout(int value, int origin, double factor) {
+    if (!std::isfinite(factor)) return value;
+    return roundScaled(origin + static_cast<double>(value - origin) * factor);
+}
+
+int scaleLength(int length, double factor) {
+    if (!std::isfinite(factor)) return length;
+    return std::max(1, roundScaled(static_cast<double>(length) * factor));
+}
+
+} // namespace
 
 // ============== Base Shape Implementation ==============
 
@@ -15,7 +117,8 @@ Shape::Shape(const std::string& name, int x, int y, int width, int height,
              int borderWidth, bool filled)
     : name(name), x(x), y(y), width(width), height(height),
       fillColor(fillColor), borderColor(borderColor),
-      borderWidth(borderWidth), rotation(0.0), filled(filled) {
+      borderWidth(borderWidth), rotation(0.0), filled(filled),
+      vertexCacheValid(false) {
 }
 
 void Shape::display() const {
@@ -32,31 +135,77 @@ void Shape::displayColored() const {
               << " " << fillColor.getName() << std::endl;
 }
 
+std::string Shape::toSVG() const {
+    SvgWriter out;
+    writeSVG(out);
+    return out.takeString();
+}
+
+SvgStyle Shape::getSVGStyle() const {
+    return SvgStyle::fillAndStroke(fillColor, borderColor, borderWidth);
+}
+
+void Shape::writeJSON(JsonWriter& out) const {
+    out.beginObject();
+    writeJSONMembers(out);
+    out.endObject();
+}
+
+void Shape::writeJSONMembers(JsonWriter& out) const {
+    out.member("type", name);
+    out.member("x", x);
+    out.member("y", y);
+    out.member("width", width);
+    out.member("height", height);
+    out.key("fillColor");
+    writeColorJSON(out, fillColor);
+    out.key("borderColor");
+    writeColorJSON(out, borderColor);
+    out.member("borderWidth", borderWidth);
+    out.member("rotation", rotation);
+    out.member("filled", filled);
+}
+
 std::string Shape::toJSON() const {
-    std::ostringstream oss;
-    oss << "{\n";
-    oss << "      \"type\": \"" << name << "\",\n";
-    oss << "      \"x\": " << x << ",\n";
-    oss << "      \"y\": " << y << ",\n";
-    oss << "      \"width\": " << width << ",\n";
-    oss << "      \"height\": " << height << ",\n";
-    oss << "      \"fillColor\": {\n";
-    oss << "        \"name\": \"" << fillColor.getName() << "\",\n";
-    oss << "        \"r\": " << (int)fillColor.r << ",\n";
-    oss << "        \"g\": " << (int)fillColor.g << ",\n";
-    oss << "        \"b\": " << (int)fillColor.b << "\n";
-    oss << "      },\n";
-    oss << "      \"borderColor\": {\n";
-    oss << "        \"name\": \"" << borderColor.getName() << "\",\n";
-    oss << "        \"r\": " << (int)borderColor.r << ",\n";
-    oss << "        \"g\": " << (int)borderColor.g << ",\n";
-    oss << "        \"b\": " << (int)borderColor.b << "\n";
-    oss << "      },\n";
-    oss << "      \"borderWidth\": " << borderWidth << ",\n";
-    oss << "      \"rotation\": " << rotation << ",\n";
-    oss << "      \"filled\": " << (filled ? "true" : "false") << "\n";
-    oss << "    }";
-    return oss.str();
+    JsonWriter out;
+    writeJSON(out);
+    return out.takeString();
+}
+
+void Shape::translate(int dx, int dy) {
+    setPosition(x + dx, y + dy);
+}
+
+void Shape::scale(double factor, int originX, int originY) {
+    setPosition(scaleAbout(x, originX, factor), scaleAbout(y, originY, factor));
+    setSize(scaleLength(width, factor), scaleLength(height, factor));
+}
+
+// ============== Polygon Shape Implementation ==============
+
+const std::vector<std::pair<int, int>>& PolygonShape::getVertices() const {
+    if (!vertexCacheValid) {
+        buildVertices(vertexCache);
+        vertexCacheValid = true;
+    }
+    return vertexCache;
+}
+
+void PolygonShape::render(Canvas& canvas) const {
+    const auto& points = getVertices();
+    
+    if (filled) {
+        canvas.fillPolygon(points, fillColor);
+    }
+    if (borderWidth > 0) {
+        canvas.drawPolygon(points, borderColor, borderWidth);
+    }
+}
+
+void PolygonShape::writeSVG(SvgWriter& out) const {
+    out.polygon(getVertices());
+    out.style(getSVGStyle());
+    out.write("/>");
 }
 
 // ============== Circle Implementation ==============
@@ -79,14 +228,14 @@ void Circle::render(Canvas& canvas) const {
     }
 }
 
-std::string Circle::toSVG() const {
-    std::ostringstream oss;
+void Circle::writeSVG(SvgWriter& out) const {
     int r = width / 2;
-    oss << "<circle cx=\"" << (x + r) << "\" cy=\"" << (y + r) << "\" r=\"" << r << "\" "
-        << "fill=\"rgb(" << (int)fillColor.r << "," << (int)fillColor.g << "," << (int)fillColor.b << ")\" "
-        << "stroke=\"rgb(" << (int)borderColor.r << "," << (int)borderColor.g << "," << (int)borderColor.b << ")\" "
-        << "stroke-width=\"" << borderWidth << "\"/>";
-    return oss.str();
+    out.write("<circle");
+    out.attribute("cx", x + r);
+    out.attribute("cy", y + r);
+    out.attribute("r", r);
+    out.style(getSVGStyle());
+    out.write("/>");
 }
 
 std::string Circle::getAsciiIcon() const {
@@ -113,13 +262,14 @@ void Rectangle::render(Canvas& canvas) const {
     }
 }
 
-std::string Rectangle::toSVG() const {
-    std::ostringstream oss;
-    oss << "<rect x=\"" << x << "\" y=\"" << y << "\" width=\"" << width << "\" height=\"" << height << "\" "
-        << "fill=\"rgb(" << (int)fillColor.r << "," << (int)fillColor.g << "," << (int)fillColor.b << ")\" "
-        << "stroke=\"rgb(" << (int)borderColor.r << "," << (int)borderColor.g << "," << (int)borderColor.b << ")\" "
-        << "stroke-width=\"" << borderWidth << "\"/>";
-    return oss.str();
+void Rectangle::writeSVG(SvgWriter& out) const {
+    out.write("<rect");
+    out.attribute("x", x);
+    out.attribute("y", y);
+    out.attribute("width", width);
+    out.attribute("height", height);
+    out.style(getSVGStyle());
+    out.write("/>");
 }
 
 std::string Rectangle::getAsciiIcon() const {
@@ -150,41 +300,31 @@ std::unique_ptr<Shape> Square::clone() const {
 
 Triangle::Triangle(int x, int y, int base, int height, const Color& fillColor,
                    const Color& borderColor, int borderWidth, bool filled)
-    : Shape("Triangle", x, y, base, height, fillColor, borderColor, borderWidth, filled) {
+    : PolygonShape("Triangle", x, y, base, height, fillColor, borderColor, borderWidth, filled) {
 }
 
-void Triangle::render(Canvas& canvas) const {
+void Triangle::buildVertices(std::vector<std::pair<int, int>>& out) const {
     // Triangle points: top-center, bottom-left, bottom-right
-    int x1 = x + width / 2;
-    int y1 = y;
-    int x2 = x;
-    int y2 = y + height;
-    int x3 = x + width;
-    int y3 = y + height;
+    out = {
+        {x + width / 2, y},
+        {x, y + height},
+        {x + width, y + height}
+    };
+}
+
+void Triangle::render(Canvas& canvas) const {
+    const auto& points = getVertices();
     
     if (filled) {
-        canvas.fillTriangle(x1, y1, x2, y2, x3, y3, fillColor);
+        canvas.fillTriangle(points[0].first, points[0].second,
+                            points[1].first, points[1].second,
+                            points[2].first, points[2].second, fillColor);
     }
     if (borderWidth > 0) {
-        canvas.drawLine(x1, y1, x2, y2, borderColor, borderWidth);
-        canvas.drawLine(x2, y2, x3, y3, borderColor, borderWidth);
-        canvas.drawLine(x3, y3, x1, y1, borderColor, borderWidth);
+        canvas.drawPolygon(points, borderColor, borderWidth);
     }
 }
 
-std::string Triangle::toSVG() const {
-    std::ostringstream oss;
-    int x1 = x + width / 2, y1 = y;
-    int x2 = x, y2 = y + height;
-    int x3 = x + width, y3 = y + height;
-    
-    oss << "<polygon points=\"" << x1 << "," << y1 << " " << x2 << "," << y2 << " " << x3 << "," << y3 << "\" "
-        << "fill=\"rgb(" << (int)fillColor.r << "," << (int)fillColor.g << "," << (int)fillColor.b << ")\" "
-        << "stroke=\"rgb(" << (int)borderColor.r << "," << (int)borderColor.g << "," << (int)borderColor.b << ")\" "
-        << "stroke-width=\"" << borderWidth << "\"/>";
-    return oss.str();
-}
-
 std::string Triangle::getAsciiIcon() const {
     return "▲";
 }
@@ -197,36 +337,16 @@ std::unique_ptr<Shape> Triangle::clone() const {
 
 Diamond::Diamond(int x, int y, int width, int height, const Color& fillColor,
                  const Color& borderColor, int borderWidth, bool filled)
-    : Shape("Diamond", x, y, width, height, fillColor, borderColor, borderWidth, filled) {
+    : PolygonShape("Diamond", x, y, width, height, fillColor, borderColor, borderWidth, filled) {
 }
 
-void Diamond::render(Canvas& canvas) const {
-    std::vector<std::pair<int, int>> points = {
+void Diamond::buildVertices(std::vector<std::pair<int, int>>& out) const {
+    out = {
         {x + width / 2, y},           // top
         {x + width, y + height / 2},  // right
         {x + width / 2, y + height},  // bottom
         {x, y + height / 2}           // left
     };
-    
-    if (filled) {
-        canvas.fillPolygon(points, fillColor);
-    }
-    if (borderWidth > 0) {
-        canvas.drawPolygon(points, borderColor, borderWidth);
-    }
-}
-
-std::string Diamond::toSVG() const {
-    std::ostringstream oss;
-    oss << "<polygon points=\""
-        << (x + width / 2) << "," << y << " "
-        << (x + width) << "," << (y + height / 2) << " "
-        << (x + width / 2) << "," << (y + height) << " "
-        << x << "," << (y + height / 2) << "\" "
-        << "fill=\"rgb(" << (int)fillColor.r << "," << (int)fillColor.g << "," << (int)fillColor.b << ")\" "
-        << "stroke=\"rgb(" << (int)borderColor.r << "," << (int)borderColor.g << "," << (int)borderColor.b << ")\" "
-        << "stroke-width=\"" << borderWidth << "\"/>";
-    return oss.str();
 }
 
 std::string Diamond::getAsciiIcon() const {
@@ -241,52 +361,13 @@ std::unique_ptr<Shape> Diamond::clone() const {
 
 Star::Star(int x, int y, int size, const Color& fillColor,
            const Color& borderColor, int borderWidth, bool filled)
-    : Shape("Star", x, y, size, size, fillColor, borderColor, borderWidth, filled) {
+    : PolygonShape("Star", x, y, size, size, fillColor, borderColor, borderWidth, filled) {
 }
 
-void Star::render(Canvas& canvas) const {
-    int cx = x + width / 2;
-    int cy = y + height / 2;
-    int outerR = width / 2;
-    int innerR = outerR * 2 / 5;
-    
-    std::vector<std::pair<int, int>> points;
-    for (int i = 0; i < 10; ++i) {
-        double angle = M_PI / 2 + i * M_PI / 5;
-        int r = (i % 2 == 0) ? outerR : innerR;
-        points.push_back({
-            cx + static_cast<int>(r * std::cos(angle)),
-            cy - static_cast<int>(r * std::sin(angle))
-        });
-    }
-    
-    if (filled) {
-        canvas.fillPolygon(points, fillColor);
-    }
-    if (borderWidth > 0) {
-        canvas.drawPolygon(points, borderColor, borderWidth);
-    }
-}
-
-std::string Star::toSVG() const {
-    std::ostringstream oss;
-    int cx = x + width / 2;
-    int cy = y + height / 2;
+void Star::buildVertices(std::vector<std::pair<int, int>>& out) const {
     int outerR = width / 2;
-    int innerR = outerR * 2 / 5;
-    
-    oss << "<polygon points=\"";
-    for (int i = 0; i < 10; ++i) {
-        double angle = M_PI / 2 + i * M_PI / 5;
-        int r = (i % 2 == 0) ? outerR : innerR;
-        if (i > 0) oss << " ";
-        oss << (cx + static_cast<int>(r * std::cos(angle))) << ","
-            << (cy - static_cast<int>(r * std::sin(angle)));
-    }
-    oss << "\" fill=\"rgb(" << (int)fillColor.r << "," << (int)fillColor.g << "," << (int)fillColor.b << ")\" "
-        << "stroke=\"rgb(" << (int)borderColor.r << "," << (int)borderColor.g << "," << (int)borderColor.b << ")\" "
-        << "stroke-width=\"" << borderWidth << "\"/>";
-    return oss.str();
+    buildRegularVertices(out, kStarUnit, x + width / 2, y + height / 2,
+                         outerR, outerR * 2 / 5, -1);
 }
 
 std::string Star::getAsciiIcon() const {
@@ -301,48 +382,12 @@ std::unique_ptr<Shape> Star::clone() const {
 
 Hexagon::Hexagon(int x, int y, int size, const Color& fillColor,
                  const Color& borderColor, int borderWidth, bool filled)
-    : Shape("Hexagon", x, y, size, size, fillColor, borderColor, borderWidth, filled) {
-}
-
-void Hexagon::render(Canvas& canvas) const {
-    int cx = x + width / 2;
-    int cy = y + height / 2;
-    int r = width / 2;
-    
-    std::vector<std::pair<int, int>> points;
-    for (int i = 0; i < 6; ++i) {
-        double angle = i * M_PI / 3;
-        points.push_back({
-            cx + static_cast<int>(r * std::cos(angle)),
-            cy + static_cast<int>(r * std::sin(angle))
-        });
-    }
-    
-    if (filled) {
-        canvas.fillPolygon(points, fillColor);
-    }
-    if (borderWidth > 0) {
-        canvas.drawPolygon(points, borderColor, borderWidth);
-    }
+    : PolygonShape("Hexagon", x, y, size, size, fillColor, borderColor, borderWidth, filled) {
 }
 
-std::string Hexagon::toSVG() const {
-    std::ostringstream oss;
-    int cx = x + width / 2;
-    int cy = y + height / 2;
+void Hexagon::buildVertices(std::vector<std::pair<int, int>>& out) const {
     int r = width / 2;
-    
-    oss << "<polygon points=\"";
-    for (int i = 0; i < 6; ++i) {
-        double angle = i * M_PI / 3;
-        if (i > 0) oss << " ";
-        oss << (cx + static_cast<int>(r * std::cos(angle))) << ","
-            << (cy + static_cast<int>(r * std::sin(angle)));
-    }
-    oss << "\" fill=\"rgb(" << (int)fillColor.r << "," << (int)fillColor.g << "," << (int)fillColor.b << ")\" "
-        << "stroke=\"rgb(" << (int)borderColor.r << "," << (int)borderColor.g << "," << (int)borderColor.b << ")\" "
-        << "stroke-width=\"" << borderWidth << "\"/>";
-    return oss.str();
+    buildRegularVertices(out, kHexagonUnit, x + width / 2, y + height / 2, r, r, 1);
 }
 
 std::string Hexagon::getAsciiIcon() const {
@@ -357,48 +402,12 @@ std::unique_ptr<Shape> Hexagon::clone() const {
 
 Pentagon::Pentagon(int x, int y, int size, const Color& fillColor,
                    const Color& borderColor, int borderWidth, bool filled)
-    : Shape("Pentagon", x, y, size, size, fillColor, borderColor, borderWidth, filled) {
-}
-
-void Pentagon::render(Canvas& canvas) const {
-    int cx = x + width / 2;
-    int cy = y + height / 2;
-    int r = width / 2;
-    
-    std::vector<std::pair<int, int>> points;
-    for (int i = 0; i < 5; ++i) {
-        double angle = M_PI / 2 + i * 2 * M_PI / 5;
-        points.push_back({
-            cx + static_cast<int>(r * std::cos(angle)),
-            cy - static_cast<int>(r * std::sin(angle))
-        });
-    }
-    
-    if (filled) {
-        canvas.fillPolygon(points, fillColor);
-    }
-    if (borderWidth > 0) {
-        canvas.drawPolygon(points, borderColor, borderWidth);
-    }
+    : PolygonShape("Pentagon", x, y, size, size, fillColor, borderColor, borderWidth, filled) {
 }
 
-std::string Pentagon::toSVG() const {
-    std::ostringstream oss;
-    int cx = x + width / 2;
-    int cy = y + height / 2;
+void Pentagon::buildVertices(std::vector<std::pair<int, int>>& out) const {
     int r = width / 2;
-    
-    oss << "<polygon points=\"";
-    for (int i = 0; i < 5; ++i) {
-        double angle = M_PI / 2 + i * 2 * M_PI / 5;
-        if (i > 0) oss << " ";
-        oss << (cx + static_cast<int>(r * std::cos(angle))) << ","
-            << (cy - static_cast<int>(r * std::sin(angle)));
-    }
-    oss << "\" fill=\"rgb(" << (int)fillColor.r << "," << (int)fillColor.g << "," << (int)fillColor.b << ")\" "
-        << "stroke=\"rgb(" << (int)borderColor.r << "," << (int)borderColor.g << "," << (int)borderColor.b << ")\" "
-        << "stroke-width=\"" << borderWidth << "\"/>";
-    return oss.str();
+    buildRegularVertices(out, kPentagonUnit, x + width / 2, y + height / 2, r, r, -1);
 }
 
 std::string Pentagon::getAsciiIcon() const {
@@ -426,29 +435,20 @@ void Oval::render(Canvas& canvas) const {
         canvas.fillEllipse(cx, cy, rx, ry, fillColor);
     }
     if (borderWidth > 0) {
-        // Draw ellipse border by drawing outer - inner
-        for (int py = -ry; py <= ry; ++py) {
-            for (int px = -rx; px <= rx; ++px) {
-                double outer = (double)(px * px) / (rx * rx) + (double)(py * py) / (ry * ry);
-                double inner = (double)(px * px) / ((rx - borderWidth) * (rx - borderWidth)) +
-                               (double)(py * py) / ((ry - borderWidth) * (ry - borderWidth));
-                if (outer <= 1.0 && inner > 1.0) {
-                    canvas.setPixel(cx + px, cy + py, borderColor);
-                }
-            }
-        }
+        canvas.drawEllipse(cx, cy, rx, ry, borderColor, borderWidth);
     }
 }
 
-std::string Oval::toSVG() const {
-    std::ostringstream oss;
+void Oval::writeSVG(SvgWriter& out) const {
     int rx = width / 2;
     int ry = height / 2;
-    oss << "<ellipse cx=\"" << (x + rx) << "\" cy=\"" << (y + ry) << "\" rx=\"" << rx << "\" ry=\"" << ry << "\" "
-        << "fill=\"rgb(" << (int)fillColor.r << "," << (int)fillColor.g << "," << (int)fillColor.b << ")\" "
-        << "stroke=\"rgb(" << (int)borderColor.r << "," << (int)borderColor.g << "," << (int)borderColor.b << ")\" "
-        << "stroke-width=\"" << borderWidth << "\"/>";
-    return oss.str();
+    out.write("<ellipse");
+    out.attribute("cx", x + rx);
+    out.attribute("cy", y + ry);
+    out.attribute("rx", rx);
+    out.attribute("ry", ry);
+    out.style(getSVGStyle());
+    out.write("/>");
 }
 
 std::string Oval::getAsciiIcon() const {
@@ -463,38 +463,17 @@ std::unique_ptr<Shape> Oval::clone() const {
 
 Trapezoid::Trapezoid(int x, int y, int width, int height, const Color& fillColor,
                      const Color& borderColor, int borderWidth, bool filled)
-    : Shape("Trapezoid", x, y, width, height, fillColor, borderColor, borderWidth, filled) {
+    : PolygonShape("Trapezoid", x, y, width, height, fillColor, borderColor, borderWidth, filled) {
 }
 
-void Trapezoid::render(Canvas& canvas) const {
+void Trapezoid::buildVertices(std::vector<std::pair<int, int>>& out) const {
     int inset = width / 4;
-    std::vector<std::pair<int, int>> points = {
+    out = {
         {x + inset, y},              // top-left
         {x + width - inset, y},      // top-right
         {x + width, y + height},     // bottom-right
         {x, y + height}              // bottom-left
     };
-    
-    if (filled) {
-        canvas.fillPolygon(points, fillColor);
-    }
-    if (borderWidth > 0) {
-        canvas.drawPolygon(points, borderColor, borderWidth);
-    }
-}
-
-std::string Trapezoid::toSVG() const {
-    std::ostringstream oss;
-    int inset = width / 4;
-    oss << "<polygon points=\""
-        << (x + inset) << "," << y << " "
-        << (x + width - inset) << "," << y << " "
-        << (x + width) << "," << (y + height) << " "
-        << x << "," << (y + height) << "\" "
-        << "fill=\"rgb(" << (int)fillColor.r << "," << (int)fillColor.g << "," << (int)fillColor.b << ")\" "
-        << "stroke=\"rgb(" << (int)borderColor.r << "," << (int)borderColor.g << "," << (int)borderColor.b << ")\" "
-        << "stroke-width=\"" << borderWidth << "\"/>";
-    return oss.str();
 }
 
 std::string Trapezoid::getAsciiIcon() const {
@@ -509,36 +488,16 @@ std::unique_ptr<Shape> Trapezoid::clone() const {
 
 Rhombus::Rhombus(int x, int y, int width, int height, const Color& fillColor,
                  const Color& borderColor, int borderWidth, bool filled)
-    : Shape("Rhombus", x, y, width, height, fillColor, borderColor, borderWidth, filled) {
+    : PolygonShape("Rhombus", x, y, width, height, fillColor, borderColor, borderWidth, filled) {
 }
 
-void Rhombus::render(Canvas& canvas) const {
-    std::vector<std::pair<int, int>> points = {
+void Rhombus::buildVertices(std::vector<std::pair<int, int>>& out) const {
+    out = {
         {x + width / 2, y},           // top
         {x + width, y + height / 2},  // right
         {x + width / 2, y + height},  // bottom
         {x, y + height / 2}           // left
     };
-    
-    if (filled) {
-        canvas.fillPolygon(points, fillColor);
-    }
-    if (borderWidth > 0) {
-        canvas.drawPolygon(points, borderColor, borderWidth);
-    }
-}
-
-std::string Rhombus::toSVG() const {
-    std::ostringstream oss;
-    oss << "<polygon points=\""
-        << (x + width / 2) << "," << y << " "
-        << (x + width) << "," << (y + height / 2) << " "
-        << (x + width / 2) << "," << (y + height) << " "
-        << x << "," << (y + height / 2) << "\" "
-        << "fill=\"rgb(" << (int)fillColor.r << "," << (int)fillColor.g << "," << (int)fillColor.b << ")\" "
-        << "stroke=\"rgb(" << (int)borderColor.r << "," << (int)borderColor.g << "," << (int)borderColor.b << ")\" "
-        << "stroke-width=\"" << borderWidth << "\"/>";
-    return oss.str();
 }
 
 std::string Rhombus::getAsciiIcon() const {
@@ -560,12 +519,38 @@ void Line::render(Canvas& canvas) const {
     canvas.drawLine(x, y, x2, y2, fillColor, borderWidth);
 }
 
-std::string Line::toSVG() const {
-    std::ostringstream oss;
-    oss << "<line x1=\"" << x << "\" y1=\"" << y << "\" x2=\"" << x2 << "\" y2=\"" << y2 << "\" "
-        << "stroke=\"rgb(" << (int)fillColor.r << "," << (int)fillColor.g << "," << (int)fillColor.b << ")\" "
-        << "stroke-width=\"" << borderWidth << "\"/>";
-    return oss.str();
+void Line::writeSVG(SvgWriter& out) const {
+    out.write("<line");
+    out.attribute("x1", x);
+    out.attribute("y1", y);
+    out.attribute("x2", x2);
+    out.attribute("y2", y2);
+    out.style(getSVGStyle());
+    out.write("/>");
+}
+
+SvgStyle Line::getSVGStyle() const {
+    return SvgStyle::strokeOnly(fillColor, borderWidth);
+}
+
+void Line::writeJSONMembers(JsonWriter& out) const {
+    Shape::writeJSONMembers(out);
+    out.member("x2", x2);
+    out.member("y2", y2);
+}
+
+void Line::translate(int dx, int dy) {
+    Shape::translate(dx, dy);
+    x2 += dx;
+    y2 += dy;
+}
+
+void Line::scale(double factor, int originX, int originY) {
+    // The end points define the line; the box only follows them
+    setPosition(scaleAbout(x, originX, factor), scaleAbout(y, originY, factor));
+    x2 = scaleAbout(x2, originX, factor);
+    y2 = scaleAbout(y2, originY, factor);
+    setSize(std::abs(x2 - x), std::abs(y2 - y));
 }
 
 std::string Line::getAsciiIcon() const {
@@ -594,13 +579,32 @@ void Text::render(Canvas& canvas) const {
     }
 }
 
-std::string Text::toSVG() const {
-    std::ostringstream oss;
-    oss << "<text x=\"" << x << "\" y=\"" << (y + fontSize) << "\" "
-        << "font-size=\"" << fontSize << "\" "
-        << "fill=\"rgb(" << (int)fillColor.r << "," << (int)fillColor.g << "," << (int)fillColor.b << ")\">"
-        << content << "</text>";
-    return oss.str();
+void Text::writeSVG(SvgWriter& out) const {
+    out.write("<text");
+    out.attribute("x", x);
+    out.attribute("y", y + fontSize);
+    out.attribute("font-size", fontSize);
+    out.style(getSVGStyle());
+    out.write('>');
+    out.write(content);
+    out.write("</text>");
+}
+
+SvgStyle Text::getSVGStyle() const {
+    return SvgStyle::fillOnly(fillColor);
+}
+
+void Text::writeJSONMembers(JsonWriter& out) const {
+    Shape::writeJSONMembers(out);
+    out.member("content", content);
+    out.member("fontSize", fontSize);
+}
+
+void Text::scale(double factor, int originX, int originY) {
+    Shape::scale(factor, originX, originY);
+    // Glyphs are drawn 8 pixels wide at any size, so only the height follows the factor
+    width = static_cast<int>(content.length()) * 8;
+    fontSize = height;
 }
 
 std::string Text::getAsciiIcon() const {
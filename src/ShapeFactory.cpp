@@ -43,7 +43,7 @@ const std::map<std::string, ShapeFactory::CreatorFunc>& ShapeFactory::getCreator
             return std::make_unique<Line>(p.x, p.y, p.x2, p.y2, p.fillColor, p.borderWidth);
         }},
         {"text", [](const ShapeParams& p) {
-            return std::make_unique<Text>(p.x, p.y, p.text, p.fillColor, 16);
+            return std::make_unique<Text>(p.x, p.y, p.text, p.fillColor, p.fontSize);
         }}
     };
     return creators;
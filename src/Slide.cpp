@@ -1,9 +1,36 @@
 #include "Slide.h"
+#include "Profiler.h"
+#include "Tracer.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <fstream>
 #include <iomanip>
 #include <sstream>
 
+namespace {
+
+/**
+ * @brief Renders shapes in runs of the same type, one trace span per run
+ */
+void renderShapeBatches(const std::vector<std::shared_ptr<Shape>>& shapes, Canvas& canvas) {
+    size_t i = 0;
+    while (i < shapes.size()) {
+        std::string type = shapes[i]->getName();
+        size_t end = i + 1;
+        while (end < shapes.size() && shapes[end]->getName() == type) ++end;
+
+        Tracer::Span batch("render", "shape batch");
+        batch.arg("type", type);
+        batch.arg("count", static_cast<int64_t>(end - i));
+        for (; i < end; ++i) {
+            shapes[i]->render(canvas);
+        }
+    }
+}
+
+} // namespace
+
 Slide::Slide(int width, int height) 
     : backgroundColor(30, 30, 45), canvasWidth(width), canvasHeight(height) {
 }
@@ -46,6 +73,90 @@ bool Slide::removeShape(size_t index) {
     return false;
 }
 
+void Slide::addShapes(const std::vector<std::shared_ptr<Shape>>& newShapes) {
+    shapes.insert(shapes.end(), newShapes.begin(), newShapes.end());
+}
+
+size_t Slide::removeShapes(const std::vector<size_t>& indices) {
+    std::vector<bool> selected = selectionMask(indices);
+    size_t kept = 0;
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        if (!selected[i]) {
+            if (kept != i) {
+                shapes[kept] = std::move(shapes[i]);
+            }
+            ++kept;
+        }
+    }
+    size_t removed = shapes.size() - kept;
+    shapes.erase(shapes.begin() + static_cast<std::ptrdiff_t>(kept), shapes.end());
+    return removed;
+}
+
+size_t Slide::removeShapesIf(const std::function<bool(const Shape&)>& predicate) {
+    size_t before = shapes.size();
+    shapes.erase(std::remove_if(shapes.begin(), shapes.end(),
+                                [&](const std::shared_ptr<Shape>& shape) { return predicate(*shape); }),
+                 shapes.end());
+    return before - shapes.size();
+}
+
+size_t Slide::transformShapes(const std::vector<size_t>& indices, const std::function<void(Shape&)>& transform) {
+    std::vector<bool> selected = selectionMask(indices);
+    size_t count = 0;
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        if (selected[i]) {
+            transform(*shapes[i]);
+            ++count;
+        }
+    }
+    return count;
+}
+
+size_t Slide::translateShapes(const std::vector<size_t>& indices, int dx, int dy) {
+    return transformShapes(indices, [dx, dy](Shape& shape) { shape.translate(dx, dy); });
+}
+
+size_t Slide::scaleShapes(const std::vector<size_t>& indices, double factor) {
+    if (!std::isfinite(factor) || factor <= 0.0) {
+        return 0;
+    }
+    // Anchor the selection at its bounding box's top-left corner
+    std::vector<bool> selected = selectionMask(indices);
+    int originX = 0;
+    int originY = 0;
+    bool first = true;
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        if (selected[i]) {
+            originX = first ? shapes[i]->getX() : std::min(originX, shapes[i]->getX());
+            originY = first ? shapes[i]->getY() : std::min(originY, shapes[i]->getY());
+            first = false;
+        }
+    }
+    return transformShapes(indices, [=](Shape& shape) { shape.scale(factor, originX, originY); });
+}
+
+size_t Slide::recolorShapes(const std::vector<size_t>& indices, const Color& fillColor) {
+    return transformShapes(indices, [&](Shape& shape) { shape.setFillColor(fillColor); });
+}
+
+size_t Slide::recolorShapes(const std::vector<size_t>& indices, const Color& fillColor, const Color& borderColor) {
+    return transformShapes(indices, [&](Shape& shape) {
+        shape.setFillColor(fillColor);
+        shape.setBorderColor(borderColor);
+    });
+}
+
+std::vector<bool> Slide::selectionMask(const std::vector<size_t>& indices) const {
+    std::vector<bool> selected(shapes.size(), false);
+    for (size_t index : indices) {
+        if (index < selected.size()) {
+            selected[index] = true;
+        }
+    }
+    return selected;
+}
+
 std::shared_ptr<Shape> Slide::getShape(size_t index) const {
     if (index < shapes.size()) {
         return shapes[index];
@@ -74,9 +185,20 @@ void Slide::showColored() const {
     }
 }
 
-Canvas Slide::render() const {
+Canvas Slide::render(bool antiAliased) const {
+    SLIDESHOW_PROFILE_SCOPE(SLIDE_RENDER);
+    Tracer::Span span("render", "Slide::render");
+    span.arg("shapes", static_cast<int64_t>(shapes.size()));
+    span.arg("antiAliased", antiAliased ? 1 : 0);
+
     Canvas canvas(canvasWidth, canvasHeight, backgroundColor);
+    canvas.setAntiAliasing(antiAliased);
     
+    if (span.isActive()) {
+        renderShapeBatches(shapes, canvas);
+        return canvas;
+    }
+
     for (const auto& shape : shapes) {
         shape->render(canvas);
     }
@@ -89,89 +211,141 @@ void Slide::displayVisual() const {
     canvas.displayAscii();
 }
 
-bool Slide::exportBMP(const std::string& filename) const {
-    Canvas canvas = render();
+bool Slide::exportBMP(const std::string& filename, bool antiAliased) const {
+    Tracer::Span span("export", "Slide::exportBMP");
+    Canvas canvas = render(antiAliased);
     return canvas.exportBMP(filename);
 }
 
-bool Slide::exportSVG(const std::string& filename) const {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
+bool Slide::exportSVG(const std::string& filename, bool optimized) const {
+    SvgWriter writer;
+    writer.setOptimized(optimized);
+    return exportSVG(filename, writer);
+}
+
+bool Slide::exportSVG(const std::string& filename, SvgWriter& writer) const {
+    SLIDESHOW_PROFILE_SCOPE(EXPORT_SVG);
+    Tracer::Span span("export", "Slide::exportSVG");
+    span.arg("file", filename);
+    if (!writer.open(filename)) {
         return false;
     }
-    
-    file << toSVG();
-    file.close();
-    return true;
+
+    writeSVG(writer);
+    span.arg("bytes", static_cast<int64_t>(writer.getBytesWritten()));
+    return writer.close();
 }
 
-bool Slide::exportJSON(const std::string& filename) const {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
+bool Slide::exportJSON(const std::string& filename, bool pretty) const {
+    JsonWriter writer;
+    writer.setPretty(pretty);
+    return exportJSON(filename, writer);
+}
+
+bool Slide::exportJSON(const std::string& filename, JsonWriter& writer) const {
+    SLIDESHOW_PROFILE_SCOPE(EXPORT_JSON);
+    Tracer::Span span("export", "Slide::exportJSON");
+    span.arg("file", filename);
+    if (!writer.open(filename)) {
         return false;
     }
-    
-    file << toJSON();
-    file.close();
-    return true;
+
+    writer.reset();
+    writeJSON(writer);
+    span.arg("bytes", static_cast<int64_t>(writer.getBytesWritten()));
+    return writer.close();
 }
 
-std::string Slide::toSVG() const {
-    std::ostringstream oss;
-    
-    oss << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-    oss << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << canvasWidth 
-        << "\" height=\"" << canvasHeight << "\">\n";
-    
-    // Background
-    oss << "  <rect width=\"100%\" height=\"100%\" fill=\"rgb("
-        << (int)backgroundColor.r << "," << (int)backgroundColor.g << "," 
-        << (int)backgroundColor.b << ")\"/>\n";
-    
+void Slide::writeSVG(SvgWriter& out) const {
+    out.write("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    out.write("<svg xmlns=\"http://www.w3.org/2000/svg\"");
+
+    // Find the paints and outlines that more than one shape uses
+    if (out.isOptimized()) {
+        out.clearShared();
+        for (const auto& shape : shapes) {
+            out.countStyle(shape->getSVGStyle());
+            if (auto polygon = dynamic_cast<const PolygonShape*>(shape.get())) {
+                out.countPolygon(polygon->getVertices());
+            }
+        }
+        if (out.hasSharedPolygons()) {
+            out.write(" xmlns:xlink=\"http://www.w3.org/1999/xlink\"");
+        }
+    }
+    out.attribute("width", canvasWidth);
+    out.attribute("height", canvasHeight);
+    out.write(">\n");
+
+    // Declare them once, before any shape refers to them
+    if (out.isOptimized()) {
+        out.writeSharedDefinitions();
+    }
+
+    // Background (always written opaque)
+    out.write("  <rect width=\"100%\" height=\"100%\"");
+    out.paint("fill", backgroundColor.withAlpha(255));
+    out.write("/>\n");
+
     // Title if present
     if (!title.empty()) {
-        oss << "  <text x=\"10\" y=\"25\" font-size=\"18\" fill=\"white\" font-weight=\"bold\">"
-            << title << "</text>\n";
+        out.write("  <text x=\"10\" y=\"25\" font-size=\"18\" fill=\"white\" font-weight=\"bold\">");
+        out.write(title);
+        out.write("</text>\n");
     }
-    
+
     // Shapes
+    bool indent = !out.isOptimized();
     for (const auto& shape : shapes) {
-        oss << "  " << shape->toSVG() << "\n";
+        if (indent) out.write("  ");
+        shape->writeSVG(out);
+        out.write('\n');
     }
-    
-    oss << "</svg>";
-    
-    return oss.str();
+
+    out.write("</svg>");
 }
 
-std::string Slide::toJSON() const {
-    std::ostringstream oss;
-    
-    oss << "{\n";
-    oss << "  \"slide\": {\n";
-    oss << "    \"title\": \"" << title << "\",\n";
-    oss << "    \"canvasWidth\": " << canvasWidth << ",\n";
-    oss << "    \"canvasHeight\": " << canvasHeight << ",\n";
-    oss << "    \"backgroundColor\": {\n";
-    oss << "      \"r\": " << (int)backgroundColor.r << ",\n";
-    oss << "      \"g\": " << (int)backgroundColor.g << ",\n";
-    oss << "      \"b\": " << (int)backgroundColor.b << "\n";
-    oss << "    },\n";
-    oss << "    \"shapes\": [\n";
-    
-    for (size_t i = 0; i < shapes.size(); ++i) {
-        oss << "    " << shapes[i]->toJSON();
-        if (i < shapes.size() - 1) {
-            oss << ",";
-        }
-        oss << "\n";
+std::string Slide::toSVG(bool optimized) const {
+    SvgWriter out;
+    out.setOptimized(optimized);
+    writeSVG(out);
+    return out.takeString();
+}
+
+uint64_t Slide::measureSVG(SvgWriter& writer) const {
+    writer.startCounting();
+    writeSVG(writer);
+    return writer.getBytesWritten();
+}
+
+void Slide::writeJSON(JsonWriter& out) const {
+    out.beginObject();
+    out.key("slide");
+    out.beginObject();
+    out.member("title", title);
+    out.member("canvasWidth", canvasWidth);
+    out.member("canvasHeight", canvasHeight);
+    out.key("backgroundColor");
+    out.beginObject();
+    out.member("r", static_cast<int>(backgroundColor.r));
+    out.member("g", static_cast<int>(backgroundColor.g));
+    out.member("b", static_cast<int>(backgroundColor.b));
+    out.endObject();
+    out.key("shapes");
+    out.beginArray();
+    for (const auto& shape : shapes) {
+        shape->writeJSON(out);
     }
-    
-    oss << "    ]\n";
-    oss << "  }\n";
-    oss << "}";
-    
-    return oss.str();
+    out.endArray();
+    out.endObject();
+    out.endObject();
+}
+
+std::string Slide::toJSON(bool pretty) const {
+    JsonWriter out;
+    out.setPretty(pretty);
+    writeJSON(out);
+    return out.takeString();
 }
 
 bool Slide::isEmpty() const {
@@ -218,8 +392,8 @@ std::string Slide::toFileFormat() const {
             << shape->getY() << ", "
             << shape->getWidth() << ", "
             << shape->getHeight() << ", "
-            << shape->getFillColor().getName() << ", "
-            << shape->getBorderColor().getName() << ", "
+            << shape->getFillColor().toString() << ", "
+            << shape->getBorderColor().toString() << ", "
             << shape->getBorderWidth() << ", "
             << (shape->isFilled() ? "true" : "false") << "\n";
     }
@@ -0,0 +1,584 @@
+#include "SlideServer.h"
+#include "Color.h"
+#include "CommandParser.h"
+#include "Profiler.h"
+#include "ShapeFactory.h"
+#include "Tokenizer.h"
+#include "Tracer.h"
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// ============== Responses ==============
+
+std::string okResponse(const std::string& summary = "", const std::string& body = "") {
+    std::string response = "OK";
+    if (!summary.empty()) {
+        response += ' ';
+        response += summary;
+    }
+    if (!body.empty()) {
+        response += '\n';
+        response += body;
+    }
+    return response;
+}
+
+std::string errorResponse(const std::string& message) {
+    return "ERR " + message;
+}
+
+// ============== Argument Parsing ==============
+
+/**
+ * @brief Names a deck by its absolute path, keeping case so distinct files never share an entry
+ */
+std::string deckKey(const std::string& filename) {
+    std::error_code error;
+    std::filesystem::path path = std::filesystem::absolute(filename, error);
+    return (error ? std::filesystem::path(filename) : path).lexically_normal().string();
+}
+
+bool parseInt(const std::string& text, int& out) {
+    try {
+        size_t used = 0;
+        out = std::stoi(text, &used);
+        return used == text.size();
+    } catch (...) {
+        return false;
+    }
+}
+
+/**
+ * @brief Resolves a 1-based shape number on a slide
+ */
+std::shared_ptr<Shape> findShape(const Slide& slide, const std::string& text) {
+    int number = 0;
+    if (!parseInt(text, number) || number < 1) {
+        return nullptr;
+    }
+    return slide.getShape(static_cast<size_t>(number - 1));
+}
+
+bool endsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() &&
+           text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// ============== Framing ==============
+
+#ifndef _WIN32
+bool readFully(int fd, char* data, size_t size) {
+    while (size > 0) {
+        ssize_t got = ::read(fd, data, size);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        data += got;
+        size -= static_cast<size_t>(got);
+    }
+    return true;
+}
+
+bool writeFully(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t sent = ::write(fd, data, size);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return false;
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+bool readFrame(int fd, std::string& payload) {
+    unsigned char header[4];
+    if (!readFully(fd, reinterpret_cast<char*>(header), sizeof(header))) return false;
+    uint32_t size = (static_cast<uint32_t>(header[0]) << 24) | (static_cast<uint32_t>(header[1]) << 16) |
+                    (static_cast<uint32_t>(header[2]) << 8) | header[3];
+    if (size > SlideServer::kMaxFrameSize) return false;
+    payload.resize(size);
+    return size == 0 || readFully(fd, &payload[0], size);
+}
+
+bool writeFrame(int fd, const std::string& payload) {
+    // Clients may refuse larger frames, and beyond 4 GB the size would not fit the header
+    if (payload.size() > SlideServer::kMaxFrameSize) {
+        return writeFrame(fd, errorResponse("response too large"));
+    }
+    uint32_t size = static_cast<uint32_t>(payload.size());
+    unsigned char header[4] = {
+        static_cast<unsigned char>(size >> 24), static_cast<unsigned char>(size >> 16),
+        static_cast<unsigned char>(size >> 8), static_cast<unsigned char>(size)
+    };
+    return writeFully(fd, reinterpret_cast<const char*>(header), sizeof(header)) &&
+           writeFully(fd, payload.data(), payload.size());
+}
+#endif
+
+} // namespace
+
+// ============== Request Table ==============
+
+const SlideServer::RequestSpec SlideServer::kRequests[] = {
+    {"ping", 0, &SlideServer::handlePing, "ping"},
+    {"load", 1, &SlideServer::handleLoad, "load <file>"},
+    {"reload", 1, &SlideServer::handleReload, "reload <file>"},
+    {"close", 1, &SlideServer::handleClose, "close <file>"},
+    {"list", 0, &SlideServer::handleList, "list"},
+    {"info", 1, &SlideServer::handleInfo, "info <file>"},
+    {"add", 3, &SlideServer::handleAdd, "add <file> <slide> <Shape, x, y, ...>"},
+    {"delete", 3, &SlideServer::handleDelete, "delete <file> <slide> <shape>"},
+    {"move", 5, &SlideServer::handleMove, "move <file> <slide> <shape> <x> <y>"},
+    {"resize", 5, &SlideServer::handleResize, "resize <file> <slide> <shape> <width> <height>"},
+    {"fill", 4, &SlideServer::handleFill, "fill <file> <slide> <shape> <color>"},
+    {"render", 3, &SlideServer::handleRender, "render <file> <slide> <svg|json|ascii>"},
+    {"export", 3, &SlideServer::handleExport, "export <file> <slide> <out.bmp|out.svg|out.json> [noaa]"},
+    {"save", 1, &SlideServer::handleSave, "save <file> [path]"},
+    {"stats", 0, &SlideServer::handleStats, "stats [on|off|reset]"},
+    {"shutdown", 0, &SlideServer::handleShutdown, "shutdown"}
+};
+
+SlideServer::SlideServer()
+    : listenFd(-1), stopping(false), requestCount(0), renderCacheHits(0) {
+}
+
+SlideServer::~SlideServer() {
+#ifndef _WIN32
+    if (listenFd >= 0) {
+        ::close(listenFd);
+        ::unlink(socketPath.c_str());
+    }
+#endif
+}
+
+bool SlideServer::isSupported() {
+#ifdef _WIN32
+    return false;
+#else
+    return true;
+#endif
+}
+
+// ============== Socket Lifecycle ==============
+
+bool SlideServer::start(const std::string& path) {
+#ifdef _WIN32
+    std::cerr << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+              << "Server mode is not supported on this platform." << std::endl;
+    (void)path;
+    return false;
+#else
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        std::cerr << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                  << "Invalid socket path: " << path << std::endl;
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    // Replace a socket left behind by an earlier run, but never a regular file
+    struct stat info;
+    if (::stat(path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+        ::unlink(path.c_str());
+    }
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 ||
+        ::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(fd, SOMAXCONN) != 0) {
+        std::cerr << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                  << "Failed to listen on " << path << ": " << std::strerror(errno) << std::endl;
+        if (fd >= 0) ::close(fd);
+        return false;
+    }
+
+    listenFd = fd;
+    socketPath = path;
+    stopping = false;
+    std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
+              << "Listening on: " << Color::Yellow().toAnsiFg() << path << Color::resetAnsi() << std::endl;
+    return true;
+#endif
+}
+
+void SlideServer::run() {
+#ifndef _WIN32
+    if (listenFd < 0) return;
+
+    // A client hanging up mid-response must not kill the server
+    std::signal(SIGPIPE, SIG_IGN);
+
+    while (!stopping) {
+        // Wake up periodically so stop() is noticed without a new connection
+        pollfd listener = {listenFd, POLLIN, 0};
+        int ready = ::poll(&listener, 1, 200);
+        if (ready < 0 && errno != EINTR) break;
+        if (ready <= 0) continue;
+
+        int fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0) continue;
+
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        clientFds.insert(fd);
+        std::thread(&SlideServer::serveClient, this, fd).detach();
+    }
+
+    // Disconnect remaining clients and wait for their threads to finish
+    {
+        std::unique_lock<std::mutex> lock(clientsMutex);
+        for (int fd : clientFds) {
+            ::shutdown(fd, SHUT_RDWR);
+        }
+        clientsDone.wait(lock, [this] { return clientFds.empty(); });
+    }
+
+    ::close(listenFd);
+    ::unlink(socketPath.c_str());
+    listenFd = -1;
+
+    std::cout << Color::Cyan().toAnsiFg() << "[INFO] " << Color::resetAnsi()
+              << "Server stopped after " << requestCount << " request(s), "
+              << renderCacheHits << " served from the render cache." << std::endl;
+#endif
+}
+
+void SlideServer::stop() {
+    stopping = true;
+}
+
+void SlideServer::serveClient(int fd) {
+#ifndef _WIN32
+    Tracer::setThreadName("client " + std::to_string(fd));
+    std::string request;
+    while (!stopping && readFrame(fd, request)) {
+        if (!writeFrame(fd, handleRequest(request))) {
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(clientsMutex);
+    clientFds.erase(fd);
+    ::close(fd);
+    clientsDone.notify_all();
+#else
+    (void)fd;
+#endif
+}
+
+// ============== Dispatch ==============
+
+std::string SlideServer::handleRequest(const std::string& request) {
+    ++requestCount;
+
+    std::vector<std::string> args = CommandParser::tokenize(request);
+    if (args.empty()) {
+        return errorResponse("Empty request");
+    }
+
+    std::string name = Tokenizer::toLower(args[0]);
+    for (const RequestSpec& spec : kRequests) {
+        if (name != spec.name) continue;
+        if (args.size() - 1 < spec.minArgs) {
+            return errorResponse(std::string("Usage: ") + spec.usage);
+        }
+        Tracer::Span span("server", spec.name);
+        return (this->*spec.handler)(args);
+    }
+    return errorResponse("Unknown request: " + args[0]);
+}
+
+/**
+ * Loads the presentation on first use. Loading happens outside the registry
+ * lock so a slow file does not hold up requests for other decks.
+ */
+std::shared_ptr<SlideServer::Deck> SlideServer::findDeck(const std::string& filename) {
+    std::string key = deckKey(filename);
+    {
+        std::lock_guard<std::mutex> lock(decksMutex);
+        auto it = decks.find(key);
+        if (it != decks.end()) return it->second;
+    }
+
+    auto deck = std::make_shared<Deck>();
+    deck->slideshow = SlideShow::isJSONFile(filename) ? SlideShow::loadJSON(filename) : SlideShow::load(filename);
+    if (!deck->slideshow) return nullptr;
+
+    // Another client may have loaded the same file meanwhile; keep the first
+    std::lock_guard<std::mutex> lock(decksMutex);
+    return decks.emplace(key, deck).first->second;
+}
+
+// ============== Presentation Requests ==============
+
+std::string SlideServer::handlePing(const std::vector<std::string>&) {
+    return okResponse("pong");
+}
+
+std::string SlideServer::handleLoad(const std::vector<std::string>& args) {
+    auto deck = findDeck(args[1]);
+    if (!deck) return errorResponse("Failed to open file: " + args[1]);
+    std::lock_guard<std::mutex> lock(deck->mutex);
+    return okResponse(std::to_string(deck->slideshow->getTotalSlides()));
+}
+
+std::string SlideServer::handleReload(const std::vector<std::string>& args) {
+    {
+        std::lock_guard<std::mutex> lock(decksMutex);
+        decks.erase(deckKey(args[1]));
+    }
+    return handleLoad(args);
+}
+
+std::string SlideServer::handleClose(const std::vector<std::string>& args) {
+    std::lock_guard<std::mutex> lock(decksMutex);
+    if (decks.erase(deckKey(args[1])) == 0) {
+        return errorResponse("Not loaded: " + args[1]);
+    }
+    return okResponse();
+}
+
+std::string SlideServer::handleList(const std::vector<std::string>&) {
+    std::vector<std::shared_ptr<Deck>> loaded;
+    {
+        std::lock_guard<std::mutex> lock(decksMutex);
+        for (const auto& pair : decks) {
+            loaded.push_back(pair.second);
+        }
+    }
+
+    std::ostringstream body;
+    for (const auto& deck : loaded) {
+        std::lock_guard<std::mutex> lock(deck->mutex);
+        body << deck->slideshow->getFilename() << ' ' << deck->slideshow->getTotalSlides()
+             << (deck->slideshow->isModified() ? " modified" : "") << '\n';
+    }
+    return okResponse(std::to_string(loaded.size()), body.str());
+}
+
+std::string SlideServer::handleInfo(const std::vector<std::string>& args) {
+    auto deck = findDeck(args[1]);
+    if (!deck) return errorResponse("Failed to open file: " + args[1]);
+    std::lock_guard<std::mutex> lock(deck->mutex);
+
+    // One line per slide: its number and shape count
+    std::ostringstream body;
+    int total = deck->slideshow->getTotalSlides();
+    for (int n = 1; n <= total; ++n) {
+        body << n << ' ' << deck->slideshow->getSlide(n)->getShapeCount() << '\n';
+    }
+    return okResponse(std::to_string(total), body.str());
+}
+
+// ============== Edit Requests ==============
+
+std::string SlideServer::handleAdd(const std::vector<std::string>& args) {
+    int slideNumber = 0;
+    if (!parseInt(args[2], slideNumber)) return errorResponse("Invalid slide number: " + args[2]);
+
+    // The rest of the request is a shape line in the presentation file format
+    std::string line;
+    for (size_t i = 3; i < args.size(); ++i) {
+        if (i > 3) line += ' ';
+        line += args[i];
+    }
+    std::vector<std::string> fields = Tokenizer::split(line, ',');
+    auto shape = fields.size() >= 3 ? ShapeFactory::createFromLine(fields) : nullptr;
+    if (!shape) return errorResponse("Invalid shape line: " + line);
+
+    auto deck = findDeck(args[1]);
+    if (!deck) return errorResponse("Failed to open file: " + args[1]);
+    std::lock_guard<std::mutex> lock(deck->mutex);
+    Slide* slide = deck->slideshow->getSlide(slideNumber);
+    if (!slide) return errorResponse("Invalid slide number: " + args[2]);
+
+    slide->addShape(std::shared_ptr<Shape>(shape.release()));
+    deck->slideshow->markSlideModified(slideNumber);
+    deck->renderCache.clear();
+    return okResponse(std::to_string(slide->getShapeCount()));
+}
+
+std::string SlideServer::handleDelete(const std::vector<std::string>& args) {
+    int slideNumber = 0;
+    int shapeNumber = 0;
+    if (!parseInt(args[2], slideNumber)) return errorResponse("Invalid slide number: " + args[2]);
+    if (!parseInt(args[3], shapeNumber)) return errorResponse("Invalid shape number: " + args[3]);
+
+    auto deck = findDeck(args[1]);
+    if (!deck) return errorResponse("Failed to open file: " + args[1]);
+    std::lock_guard<std::mutex> lock(deck->mutex);
+    Slide* slide = deck->slideshow->getSlide(slideNumber);
+    if (!slide) return errorResponse("Invalid slide number: " + args[2]);
+    if (shapeNumber < 1 || !slide->removeShape(static_cast<size_t>(shapeNumber - 1))) {
+        return errorResponse("Invalid shape number: " + args[3]);
+    }
+
+    deck->slideshow->markSlideModified(slideNumber);
+    deck->renderCache.clear();
+    return okResponse(std::to_string(slide->getShapeCount()));
+}
+
+std::string SlideServer::handleMove(const std::vector<std::string>& args) {
+    int slideNumber = 0;
+    int x = 0;
+    int y = 0;
+    if (!parseInt(args[2], slideNumber)) return errorResponse("Invalid slide number: " + args[2]);
+    if (!parseInt(args[4], x) || !parseInt(args[5], y)) return errorResponse("Invalid coordinates.");
+
+    auto deck = findDeck(args[1]);
+    if (!deck) return errorResponse("Failed to open file: " + args[1]);
+    std::lock_guard<std::mutex> lock(deck->mutex);
+    Slide* slide = deck->slideshow->getSlide(slideNumber);
+    if (!slide) return errorResponse("Invalid slide number: " + args[2]);
+    auto shape = findShape(*slide, args[3]);
+    if (!shape) return errorResponse("Invalid shape number: " + args[3]);
+
+    shape->setPosition(x, y);
+    deck->slideshow->markSlideModified(slideNumber);
+    deck->renderCache.clear();
+    return okResponse();
+}
+
+std::string SlideServer::handleResize(const std::vector<std::string>& args) {
+    int slideNumber = 0;
+    int width = 0;
+    int height = 0;
+    if (!parseInt(args[2], slideNumber)) return errorResponse("Invalid slide number: " + args[2]);
+    if (!parseInt(args[4], width) || !parseInt(args[5], height)) return errorResponse("Invalid size.");
+
+    auto deck = findDeck(args[1]);
+    if (!deck) return errorResponse("Failed to open file: " + args[1]);
+    std::lock_guard<std::mutex> lock(deck->mutex);
+    Slide* slide = deck->slideshow->getSlide(slideNumber);
+    if (!slide) return errorResponse("Invalid slide number: " + args[2]);
+    auto shape = findShape(*slide, args[3]);
+    if (!shape) return errorResponse("Invalid shape number: " + args[3]);
+
+    shape->setSize(width, height);
+    deck->slideshow->markSlideModified(slideNumber);
+    deck->renderCache.clear();
+    return okResponse();
+}
+
+std::string SlideServer::handleFill(const std::vector<std::string>& args) {
+    int slideNumber = 0;
+    if (!parseInt(args[2], slideNumber)) return errorResponse("Invalid slide number: " + args[2]);
+
+    auto deck = findDeck(args[1]);
+    if (!deck) return errorResponse("Failed to open file: " + args[1]);
+    std::lock_guard<std::mutex> lock(deck->mutex);
+    Slide* slide = deck->slideshow->getSlide(slideNumber);
+    if (!slide) return errorResponse("Invalid slide number: " + args[2]);
+    auto shape = findShape(*slide, args[3]);
+    if (!shape) return errorResponse("Invalid shape number: " + args[3]);
+
+    shape->setFillColor(Color(args[4]));
+    deck->slideshow->markSlideModified(slideNumber);
+    deck->renderCache.clear();
+    return okResponse(shape->getFillColor().toString());
+}
+
+// ============== Output Requests ==============
+
+std::string SlideServer::handleRender(const std::vector<std::string>& args) {
+    int slideNumber = 0;
+    if (!parseInt(args[2], slideNumber)) return errorResponse("Invalid slide number: " + args[2]);
+    std::string format = Tokenizer::toLower(args[3]);
+    if (format != "svg" && format != "json" && format != "ascii") {
+        return errorResponse("Unknown format: " + args[3]);
+    }
+
+    auto deck = findDeck(args[1]);
+    if (!deck) return errorResponse("Failed to open file: " + args[1]);
+    std::lock_guard<std::mutex> lock(deck->mutex);
+    const Slide* slide = deck->slideshow->getSlide(slideNumber);
+    if (!slide) return errorResponse("Invalid slide number: " + args[2]);
+
+    std::string key = std::to_string(slideNumber) + ':' + format;
+    auto cached = deck->renderCache.find(key);
+    if (cached != deck->renderCache.end()) {
+        ++renderCacheHits;
+        return okResponse(format, cached->second);
+    }
+
+    std::string output;
+    if (format == "svg") {
+        output = slide->toSVG();
+    } else if (format == "json") {
+        output = slide->toJSON();
+    } else {
+        output = slide->render().toAsciiArt();
+    }
+    return okResponse(format, deck->renderCache.emplace(key, std::move(output)).first->second);
+}
+
+std::string SlideServer::handleExport(const std::vector<std::string>& args) {
+    int slideNumber = 0;
+    if (!parseInt(args[2], slideNumber)) return errorResponse("Invalid slide number: " + args[2]);
+    const std::string& output = args[3];
+    bool antiAliased = !(args.size() >= 5 && Tokenizer::toLower(args[4]) == "noaa");
+
+    auto deck = findDeck(args[1]);
+    if (!deck) return errorResponse("Failed to open file: " + args[1]);
+    std::lock_guard<std::mutex> lock(deck->mutex);
+    const Slide* slide = deck->slideshow->getSlide(slideNumber);
+    if (!slide) return errorResponse("Invalid slide number: " + args[2]);
+
+    bool success;
+    if (endsWith(output, ".svg")) {
+        success = slide->exportSVG(output);
+    } else if (endsWith(output, ".json")) {
+        success = slide->exportJSON(output);
+    } else {
+        success = slide->exportBMP(output, antiAliased);
+    }
+    return success ? okResponse(output) : errorResponse("Failed to export: " + output);
+}
+
+std::string SlideServer::handleSave(const std::vector<std::string>& args) {
+    auto deck = findDeck(args[1]);
+    if (!deck) return errorResponse("Failed to open file: " + args[1]);
+    std::lock_guard<std::mutex> lock(deck->mutex);
+
+    std::string path = args.size() >= 3 ? args[2] : "";
+    if (!deck->slideshow->save(path)) {
+        return errorResponse("Failed to save file.");
+    }
+    return okResponse(deck->slideshow->getFilename());
+}
+
+std::string SlideServer::handleStats(const std::vector<std::string>& args) {
+    if (args.size() > 1) {
+        std::string action = Tokenizer::toLower(args[1]);
+        if (action == "on") {
+            Profiler::setEnabled(true);
+        } else if (action == "off") {
+            Profiler::setEnabled(false);
+        } else if (action == "reset") {
+            Profiler::reset();
+        } else {
+            return errorResponse("Usage: stats [on|off|reset]");
+        }
+        return okResponse();
+    }
+    return okResponse(Profiler::isEnabled() ? "on" : "off", Profiler::report());
+}
+
+std::string SlideServer::handleShutdown(const std::vector<std::string>&) {
+    stop();
+    return okResponse();
+}
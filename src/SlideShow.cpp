@@ -1,21 +1,400 @@
 #include "SlideShow.h"
+#include "BufferedWriter.h"
 #include "Color.h"
+#include "EditJournal.h"
+#include "FileSync.h"
+#include "JsonReader.h"
+#include "Profiler.h"
+#include "ShapeFactory.h"
+#include "Tracer.h"
+#include "TerminalRenderer.h"
+#include "Tokenizer.h"
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Prints the outcome of loading a presentation
+ */
+void reportLoaded(const SlideShow& slideshow, const std::string& filename) {
+    if (slideshow.isEmpty()) {
+        std::cerr << Color::Yellow().toAnsiFg() << "[WARN] " << Color::resetAnsi()
+                  << "No slides found in: " << filename << std::endl;
+    } else {
+        std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
+                  << "Loaded " << slideshow.getTotalSlides() << " slide(s) from: " 
+                  << Color::Yellow().toAnsiFg() << filename << Color::resetAnsi() << std::endl;
+    }
+}
+
+/**
+ * @brief Converts LF line endings to CRLF
+ */
+std::string withCrlf(const std::string& text) {
+    std::string converted;
+    converted.reserve(text.size() + text.size() / 16);
+    for (char c : text) {
+        if (c == '\n') converted += '\r';
+        converted += c;
+    }
+    return converted;
+}
+
+/**
+ * @brief Flushes a fully written temporary file and moves it over the target
+ * The temporary file takes over the target's permissions. The rename itself
+ * is durable only once the parent directory has been synced as well.
+ */
+bool replaceFile(const std::string& tempFilename, const std::string& filename) {
+    std::error_code error;
+    auto status = std::filesystem::status(filename, error);
+    if (!error && std::filesystem::exists(status)) {
+        std::filesystem::permissions(tempFilename, status.permissions(),
+                                     std::filesystem::perm_options::replace, error);
+        if (error) {
+            return false;
+        }
+    }
+    if (!FileSync::syncFile(tempFilename)) {
+        return false;
+    }
+    std::filesystem::rename(tempFilename, filename, error);
+    return !error;
+}
+
+/**
+ * @brief Builds slides and shapes from JsonReader events
+ * Accepts a whole-deck export ({"slideshow": {"slides": [{"slide": ...}]}})
+ * or a single-slide export ({"slide": ...}). Members the loader does not
+ * know, and anything nested inside them, are skipped.
+ */
+class DeckJsonHandler : public JsonReader::Handler {
+public:
+    explicit DeckJsonHandler(SlideShow& slideshow) : slideshow(slideshow) {}
+
+    int getSkippedShapes() const { return skippedShapes; }
+
+    bool beginObject() override {
+        Scope scope = childScope(false);
+        scopes.push_back(scope);
+        if (scope == Scope::Slide) {
+            slide = Slide();
+        } else if (scope == Scope::Shape) {
+            params = ShapeFactory::ShapeParams();
+            type.clear();
+            rotation = 0.0;
+            hasEndPoint = false;
+        } else if (scope == Scope::Background || scope == Scope::FillColor || scope == Scope::BorderColor) {
+            color = Color(0, 0, 0);
+        }
+        return true;
+    }
+
+    bool endObject() override {
+        Scope scope = scopes.back();
+        scopes.pop_back();
+        switch (scope) {
+            case Scope::Slide:
+                slideshow.addSlide(std::move(slide));
+                break;
+            case Scope::Background:
+                slide.setBackgroundColor(color);
+                break;
+            case Scope::FillColor:
+                params.fillColor = color;
+                break;
+            case Scope::BorderColor:
+                params.borderColor = color;
+                break;
+            case Scope::Shape:
+                addShape();
+                break;
+            default:
+                break;
+        }
+        return true;
+    }
+
+    bool beginArray() override {
+        scopes.push_back(childScope(true));
+        return true;
+    }
+
+    bool endArray() override {
+        scopes.pop_back();
+        return true;
+    }
+
+    bool key(std::string_view name) override {
+        currentKey = name;
+        return true;
+    }
+
+    bool string(std::string_view text) override {
+        Scope scope = currentScope();
+        if (scope == Scope::Slide && currentKey == "title") {
+            slide.setTitle(std::string(text));
+        } else if (scope == Scope::Shape && currentKey == "type") {
+            type = text;
+        } else if (scope == Scope::Shape && currentKey == "content") {
+            params.text = text;
+        }
+        return true;
+    }
+
+    bool number(double value) override {
+        Scope scope = currentScope();
+        if (scope == Scope::Shape) {
+            setShapeNumber(value);
+        } else if (scope == Scope::Background || scope == Scope::FillColor || scope == Scope::BorderColor) {
+            setColorChannel(value);
+        }
+        return true;
+    }
+
+    bool boolean(bool value) override {
+        if (currentScope() == Scope::Shape && currentKey == "filled") {
+            params.filled = value;
+        }
+        return true;
+    }
+
+private:
+    enum class Scope {
+        None, Document, Deck, SlideList, SlideEntry, Slide, Background,
+        ShapeList, Shape, FillColor, BorderColor, Ignored
+    };
+
+    SlideShow& slideshow;
+    std::vector<Scope> scopes;
+    std::string currentKey;
+
+    Slide slide;
+    ShapeFactory::ShapeParams params;
+    std::string type;
+    double rotation = 0.0;
+    bool hasEndPoint = false;
+    Color color;
+    int skippedShapes = 0;
+
+    Scope currentScope() const {
+        return scopes.empty() ? Scope::None : scopes.back();
+    }
+
+    Scope childScope(bool isArray) const {
+        switch (currentScope()) {
+            case Scope::None:
+                return isArray ? Scope::Ignored : Scope::Document;
+            case Scope::Document:
+                if (isArray) break;
+                if (currentKey == "slideshow") return Scope::Deck;
+                if (currentKey == "slide") return Scope::Slide;
+                break;
+            case Scope::Deck:
+                if (isArray && currentKey == "slides") return Scope::SlideList;
+                break;
+            case Scope::SlideList:
+                return isArray ? Scope::Ignored : Scope::SlideEntry;
+            case Scope::SlideEntry:
+                if (!isArray && currentKey == "slide") return Scope::Slide;
+                break;
+            case Scope::Slide:
+                if (isArray && currentKey == "shapes") return Scope::ShapeList;
+                if (!isArray && currentKey == "backgroundColor") return Scope::Background;
+                break;
+            case Scope::ShapeList:
+                return isArray ? Scope::Ignored : Scope::Shape;
+            case Scope::Shape:
+                if (isArray) break;
+                if (currentKey == "fillColor") return Scope::FillColor;
+                if (currentKey == "borderColor") return Scope::BorderColor;
+                break;
+            default:
+                break;
+        }
+        return Scope::Ignored;
+    }
+
+    void setShapeNumber(double value) {
+        int number = static_cast<int>(value);
+        if (currentKey == "x") params.x = number;
+        else if (currentKey == "y") params.y = number;
+        else if (currentKey == "width") params.width = number;
+        else if (currentKey == "height") params.height = number;
+        else if (currentKey == "borderWidth") params.borderWidth = number;
+        else if (currentKey == "fontSize") params.fontSize = number;
+        else if (currentKey == "rotation") rotation = value;
+        else if (currentKey == "x2") { params.x2 = number; hasEndPoint = true; }
+        else if (currentKey == "y2") { params.y2 = number; hasEndPoint = true; }
+    }
+
+    void setColorChannel(double value) {
+        uint8_t channel = static_cast<uint8_t>(value < 0.0 ? 0.0 : (value > 255.0 ? 255.0 : value));
+        if (currentKey == "r") color.r = channel;
+        else if (currentKey == "g") color.g = channel;
+        else if (currentKey == "b") color.b = channel;
+        else if (currentKey == "a") color.a = channel;
+    }
+
+    void addShape() {
+        // Older exports have no end point; a line then runs across its bounding box
+        if (!hasEndPoint) {
+            params.x2 = params.x + params.width;
+            params.y2 = params.y + params.height;
+        }
+        auto shape = ShapeFactory::create(type, params);
+        if (!shape) {
+            ++skippedShapes;
+            return;
+        }
+        shape->setRotation(rotation);
+        slide.addShape(std::shared_ptr<Shape>(shape.release()));
+    }
+};
+
+} // namespace
 
 SlideShow::SlideShow(const std::string& filename) 
-    : currentSlideIndex(0), filename(filename), modified(false) {
+    : currentSlideIndex(0), filename(filename), modified(false), sourceSize(0), crlf(false) {
+}
+
+SlideShow::~SlideShow() = default;
+SlideShow::SlideShow(SlideShow&&) noexcept = default;
+SlideShow& SlideShow::operator=(SlideShow&&) noexcept = default;
+
+std::unique_ptr<SlideShow> SlideShow::load(const std::string& filename) {
+    SLIDESHOW_PROFILE_SCOPE(LOAD);
+    // Binary, so byte offsets match the file; CRLF is handled below
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                  << "Failed to open file: " << filename << std::endl;
+        return nullptr;
+    }
+
+    auto slideshow = std::make_unique<SlideShow>(filename);
+    Slide currentSlide;
+    std::string line;
+    bool hasContent = false;
+    uint64_t slideStart = 0;  // Offset of the current slide's first line
+    uint64_t nextLine = 0;
+
+    while (std::getline(file, line)) {
+        uint64_t lineStart = nextLine;
+        nextLine += line.size() + (file.eof() ? 0 : 1);
+        if (lineStart == 0 && !file.eof()) {
+            slideshow->crlf = !line.empty() && line.back() == '\r';
+        }
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        std::string trimmedLine = Tokenizer::trim(line);
+        
+        // Check for slide separator
+        if (trimmedLine == "---") {
+            slideshow->addSlide(std::move(currentSlide));
+            slideshow->sources.back() = SlideSource{slideStart, lineStart - slideStart, true};
+            slideStart = nextLine;
+            currentSlide = Slide();
+            hasContent = false;
+            continue;
+        }
+        
+        // Skip empty lines
+        if (trimmedLine.empty()) {
+            continue;
+        }
+        
+        // Parse shape using factory
+        std::vector<std::string> tokens = Tokenizer::split(trimmedLine, ',');
+        if (tokens.size() >= 3) {
+            auto shape = ShapeFactory::createFromLine(tokens);
+            if (shape) {
+                currentSlide.addShape(std::shared_ptr<Shape>(shape.release()));
+                hasContent = true;
+            } else {
+                std::cerr << Color::Yellow().toAnsiFg() << "[WARN] " << Color::resetAnsi()
+                          << "Unknown shape in " << filename << ": " << line << std::endl;
+            }
+        } else {
+            std::cerr << Color::Yellow().toAnsiFg() << "[WARN] " << Color::resetAnsi()
+                      << "Invalid line format in " << filename << ": " << line << std::endl;
+        }
+    }
+    
+    // Add the last slide if it has content
+    if (hasContent || currentSlide.getShapeCount() > 0) {
+        slideshow->addSlide(std::move(currentSlide));
+        slideshow->sources.back() = SlideSource{slideStart, nextLine - slideStart, true};
+    }
+
+    file.close();
+    slideshow->setSourceFile(filename);
+    reportLoaded(*slideshow, filename);
+    return slideshow;
+}
+
+std::unique_ptr<SlideShow> SlideShow::loadJSON(const std::string& filename) {
+    SLIDESHOW_PROFILE_SCOPE(LOAD);
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                  << "Failed to open file: " << filename << std::endl;
+        return nullptr;
+    }
+
+    // Read the whole file with one allocation; the parser works on it in place
+    std::string text(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    file.read(&text[0], static_cast<std::streamsize>(text.size()));
+    file.close();
+
+    auto slideshow = std::make_unique<SlideShow>(filename);
+    DeckJsonHandler handler(*slideshow);
+    JsonReader reader;
+    if (!reader.parse(text, handler)) {
+        std::cerr << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                  << "Invalid JSON in " << filename << ": " << reader.getError() << std::endl;
+        return nullptr;
+    }
+
+    if (handler.getSkippedShapes() > 0) {
+        std::cerr << Color::Yellow().toAnsiFg() << "[WARN] " << Color::resetAnsi()
+                  << "Skipped " << handler.getSkippedShapes() << " shape(s) of unknown type in: "
+                  << filename << std::endl;
+    }
+    reportLoaded(*slideshow, filename);
+    return slideshow;
+}
+
+bool SlideShow::isJSONFile(const std::string& filename) {
+    return filename.size() > 5 && Tokenizer::toLower(filename.substr(filename.size() - 5)) == ".json";
 }
 
 void SlideShow::addSlide(const Slide& slide) {
     slides.push_back(slide);
+    sources.emplace_back();
+}
+
+void SlideShow::addSlide(Slide&& slide) {
+    slides.push_back(std::move(slide));
+    sources.emplace_back();
 }
 
 int SlideShow::addNewSlide() {
     slides.push_back(Slide());
+    sources.emplace_back();
     modified = true;
-    return static_cast<int>(slides.size());
+    int slideNumber = static_cast<int>(slides.size());
+    if (journal) {
+        journal->append(EditJournal::Op::InsertSlide, slideNumber);
+    }
+    return slideNumber;
 }
 
 bool SlideShow::removeSlide(int slideNumber) {
@@ -24,7 +403,11 @@ bool SlideShow::removeSlide(int slideNumber) {
     }
     
     slides.erase(slides.begin() + slideNumber - 1);
+    sources.erase(sources.begin() + slideNumber - 1);
     modified = true;
+    if (journal) {
+        journal->append(EditJournal::Op::RemoveSlide, slideNumber);
+    }
     
     // Adjust current index if needed
     if (currentSlideIndex >= static_cast<int>(slides.size())) {
@@ -108,6 +491,31 @@ void SlideShow::showVisual() const {
     slides[currentSlideIndex].showColored();
 }
 
+void SlideShow::showVisual(TerminalRenderer& renderer) const {
+    if (slides.empty()) {
+        std::cout << Color::Yellow().toAnsiFg() << "[WARN] No slides to display." 
+                  << Color::resetAnsi() << std::endl;
+        return;
+    }
+    
+    const Slide& slide = slides[currentSlideIndex];
+    std::ostringstream header;
+    header << Color::Cyan().toAnsiFg() 
+           << "══════════════ Slide " << (currentSlideIndex + 1) << "/" << slides.size() 
+           << " ══════════════";
+    if (!slide.getTitle().empty()) {
+        header << Color::Yellow().toAnsiFg() << "  " << slide.getTitle();
+    }
+    header << Color::resetAnsi();
+    
+    size_t bytes = renderer.present(slide.render(), header.str());
+    std::cout << Color::Gray().toAnsiFg() << "[INFO] Frame: " << bytes << " bytes, "
+              << renderer.getLastChangedCells() << " cells redrawn" 
+              << Color::resetAnsi() << std::endl;
+    
+    slide.showColored();
+}
+
 bool SlideShow::gotoSlide(int slideNumber) {
     if (slideNumber < 1 || slideNumber > static_cast<int>(slides.size())) {
         return false;
@@ -146,25 +554,50 @@ const Slide* SlideShow::getCurrentSlide() const {
     return &slides[currentSlideIndex];
 }
 
-bool SlideShow::exportCurrentSlideBMP(const std::string& filename) const {
+Slide* SlideShow::getSlide(int slideNumber) {
+    if (slideNumber < 1 || slideNumber > static_cast<int>(slides.size())) {
+        return nullptr;
+    }
+    return &slides[slideNumber - 1];
+}
+
+const Slide* SlideShow::getSlide(int slideNumber) const {
+    if (slideNumber < 1 || slideNumber > static_cast<int>(slides.size())) {
+        return nullptr;
+    }
+    return &slides[slideNumber - 1];
+}
+
+bool SlideShow::exportCurrentSlideBMP(const std::string& filename, bool antiAliased) const {
+    if (slides.empty()) {
+        return false;
+    }
+    return slides[currentSlideIndex].exportBMP(filename, antiAliased);
+}
+
+bool SlideShow::exportCurrentSlideSVG(const std::string& filename, bool optimized) const {
     if (slides.empty()) {
         return false;
     }
-    return slides[currentSlideIndex].exportBMP(filename);
+    return slides[currentSlideIndex].exportSVG(filename, optimized);
 }
 
-bool SlideShow::exportCurrentSlideSVG(const std::string& filename) const {
+bool SlideShow::exportCurrentSlideSVG(const std::string& filename, SvgWriter& writer) const {
     if (slides.empty()) {
         return false;
     }
-    return slides[currentSlideIndex].exportSVG(filename);
+    return slides[currentSlideIndex].exportSVG(filename, writer);
 }
 
-void SlideShow::exportAllSlidesBMP(const std::string& prefix) const {
+void SlideShow::exportAllSlidesBMP(const std::string& prefix, bool antiAliased) const {
+    Tracer::Span span("export", "SlideShow::exportAllSlidesBMP");
+    span.arg("slides", static_cast<int64_t>(slides.size()));
     for (size_t i = 0; i < slides.size(); ++i) {
         std::ostringstream oss;
         oss << prefix << "_" << (i + 1) << ".bmp";
-        if (slides[i].exportBMP(oss.str())) {
+        Tracer::Span slideSpan("export", "slide");
+        slideSpan.arg("slide", static_cast<int64_t>(i + 1));
+        if (slides[i].exportBMP(oss.str(), antiAliased)) {
             std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
                       << "Exported: " << oss.str() << std::endl;
         } else {
@@ -174,32 +607,62 @@ void SlideShow::exportAllSlidesBMP(const std::string& prefix) const {
     }
 }
 
-void SlideShow::exportAllSlidesSVG(const std::string& prefix) const {
+void SlideShow::exportAllSlidesSVG(const std::string& prefix, bool optimized) const {
+    Tracer::Span span("export", "SlideShow::exportAllSlidesSVG");
+    span.arg("slides", static_cast<int64_t>(slides.size()));
+    SvgWriter writer;
+    writer.setOptimized(optimized);
+    SvgWriter plainCounter;  // Measures the plain form the savings are reported against
+    uint64_t plainTotal = 0;
+    uint64_t optimizedTotal = 0;
     for (size_t i = 0; i < slides.size(); ++i) {
         std::ostringstream oss;
         oss << prefix << "_" << (i + 1) << ".svg";
-        if (slides[i].exportSVG(oss.str())) {
+        Tracer::Span slideSpan("export", "slide");
+        slideSpan.arg("slide", static_cast<int64_t>(i + 1));
+        if (slides[i].exportSVG(oss.str(), writer)) {
             std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
-                      << "Exported: " << oss.str() << std::endl;
+                      << "Exported: " << oss.str();
+            if (optimized) {
+                uint64_t optimizedBytes = writer.getBytesWritten();
+                uint64_t plainBytes = slides[i].measureSVG(plainCounter);
+                plainTotal += plainBytes;
+                optimizedTotal += optimizedBytes;
+                std::cout << Color::Gray().toAnsiFg() << " ("
+                          << SvgWriter::describeReduction(plainBytes, optimizedBytes) << ")"
+                          << Color::resetAnsi();
+            }
+            std::cout << std::endl;
         } else {
             std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
                       << "Failed to export: " << oss.str() << std::endl;
         }
     }
+
+    if (optimized && optimizedTotal > 0) {
+        std::cout << Color::Cyan().toAnsiFg() << "[INFO] " << Color::resetAnsi()
+                  << "Optimized SVG total: " << SvgWriter::describeReduction(plainTotal, optimizedTotal) << std::endl;
+    }
 }
 
-bool SlideShow::exportCurrentSlideJSON(const std::string& filename) const {
+bool SlideShow::exportCurrentSlideJSON(const std::string& filename, bool pretty) const {
     if (slides.empty()) {
         return false;
     }
-    return slides[currentSlideIndex].exportJSON(filename);
+    return slides[currentSlideIndex].exportJSON(filename, pretty);
 }
 
-void SlideShow::exportAllSlidesJSON(const std::string& prefix) const {
+void SlideShow::exportAllSlidesJSON(const std::string& prefix, bool pretty) const {
+    Tracer::Span span("export", "SlideShow::exportAllSlidesJSON");
+    span.arg("slides", static_cast<int64_t>(slides.size()));
+    JsonWriter writer;
+    writer.setPretty(pretty);
     for (size_t i = 0; i < slides.size(); ++i) {
         std::ostringstream oss;
         oss << prefix << "_" << (i + 1) << ".json";
-        if (slides[i].exportJSON(oss.str())) {
+        Tracer::Span slideSpan("export", "slide");
+        slideSpan.arg("slide", static_cast<int64_t>(i + 1));
+        if (slides[i].exportJSON(oss.str(), writer)) {
             std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
                       << "Exported: " << oss.str() << std::endl;
         } else {
@@ -209,71 +672,262 @@ void SlideShow::exportAllSlidesJSON(const std::string& prefix) const {
     }
 }
 
-bool SlideShow::exportSlideshowJSON(const std::string& filename) const {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
+bool SlideShow::exportSlideshowJSON(const std::string& filename, bool pretty) const {
+    SLIDESHOW_PROFILE_SCOPE(EXPORT_JSON);
+    Tracer::Span span("export", "SlideShow::exportSlideshowJSON");
+    span.arg("file", filename);
+    JsonWriter writer;
+    writer.setPretty(pretty);
+    if (!writer.open(filename)) {
         return false;
     }
-    
-    file << "{\n";
-    file << "  \"slideshow\": {\n";
-    file << "    \"filename\": \"" << this->filename << "\",\n";
-    file << "    \"totalSlides\": " << slides.size() << ",\n";
-    file << "    \"slides\": [\n";
-    
-    for (size_t i = 0; i < slides.size(); ++i) {
-        // Get the slide JSON and indent it properly
-        std::string slideJson = slides[i].toJSON();
-        
-        // Add proper indentation
-        std::istringstream iss(slideJson);
-        std::string line;
-        bool first = true;
-        while (std::getline(iss, line)) {
-            if (!first) {
-                file << "\n";
-            }
-            file << "      " << line;
-            first = false;
+
+    writer.beginObject();
+    writer.key("slideshow");
+    writer.beginObject();
+    writer.member("filename", this->filename);
+    writer.member("totalSlides", static_cast<int64_t>(slides.size()));
+    writer.key("slides");
+    writer.beginArray();
+    for (const auto& slide : slides) {
+        slide.writeJSON(writer);
+    }
+    writer.endArray();
+    writer.endObject();
+    writer.endObject();
+    writer.write('\n');
+
+    span.arg("bytes", static_cast<int64_t>(writer.getBytesWritten()));
+    return writer.close();
+}
+
+void SlideShow::setModified(bool m) {
+    modified = m;
+    if (m) {
+        for (auto& source : sources) {
+            source.clean = false;
         }
-        
-        if (i < slides.size() - 1) {
-            file << ",";
+        for (size_t i = 0; i < slides.size(); ++i) {
+            journalSlide(static_cast<int>(i) + 1);
         }
-        file << "\n";
     }
-    
-    file << "    ]\n";
-    file << "  }\n";
-    file << "}\n";
-    
-    file.close();
-    return true;
+}
+
+void SlideShow::markSlideModified(int slideNumber) {
+    modified = true;
+    if (slideNumber >= 1 && slideNumber <= static_cast<int>(sources.size())) {
+        sources[slideNumber - 1].clean = false;
+        journalSlide(slideNumber);
+    }
+}
+
+int SlideShow::getDirtySlideCount() const {
+    if (!isSourceUnchanged()) {
+        return static_cast<int>(slides.size());
+    }
+    int dirty = 0;
+    for (const auto& source : sources) {
+        if (!source.clean) ++dirty;
+    }
+    return dirty;
 }
 
 bool SlideShow::save(const std::string& newFilename) {
+    SLIDESHOW_PROFILE_SCOPE(SAVE);
     std::string saveFilename = newFilename.empty() ? filename : newFilename;
-    
-    std::ofstream file(saveFilename);
-    if (!file.is_open()) {
+    std::string tempFilename = saveFilename + ".tmp";
+    Tracer::Span span("io", "SlideShow::save");
+    span.arg("file", saveFilename);
+    span.arg("formatted", static_cast<int64_t>(getDirtySlideCount()));
+
+    // Decks opened from JSON stay JSON
+    bool json = isJSONFile(saveFilename);
+    std::vector<SlideSource> written;
+    bool ok = json ? exportSlideshowJSON(tempFilename) : writeTextFile(tempFilename, written);
+    if (ok) {
+        ok = replaceFile(tempFilename, saveFilename);
+    }
+    if (!ok) {
+        std::error_code error;
+        std::filesystem::remove(tempFilename, error);
         return false;
     }
-    
-    for (size_t i = 0; i < slides.size(); ++i) {
-        file << slides[i].toFileFormat();
-        
-        // Add slide separator between slides (not after last)
-        if (i < slides.size() - 1) {
-            file << "---\n";
-        }
+
+    if (json) {
+        sources.assign(slides.size(), SlideSource());
+        sourcePath.clear();
+    } else {
+        sources = std::move(written);
+        setSourceFile(saveFilename);
     }
-    
-    file.close();
-    
-    if (!newFilename.empty()) {
-        filename = newFilename;
+    filename = saveFilename;
+
+    // Until the rename is on disk a crash may bring back the old file, which the journal still restores
+    if (!FileSync::syncParentDirectory(filename)) {
+        return false;
     }
     modified = false;
-    
+
+    // The saved file holds every journaled edit; start over next to it
+    if (journal) {
+        journal->discard();
+        journal = std::make_unique<EditJournal>(filename);
+    }
     return true;
 }
+
+int SlideShow::enableJournal() {
+    journal = std::make_unique<EditJournal>(filename);
+
+    // Decode SetSlide payloads with one reader into one scratch deck
+    SlideShow decoded("");
+    DeckJsonHandler handler(decoded);
+    JsonReader reader;
+    int recovered = journal->replay([&](const EditJournal::Record& record) {
+        int count = static_cast<int>(slides.size());
+        int index = record.slideNumber - 1;
+        switch (record.op) {
+            case EditJournal::Op::SetSlide:
+                decoded.slides.clear();
+                if (index < 0 || index >= count || !reader.parse(record.payload, handler)
+                        || decoded.slides.size() != 1) {
+                    return false;
+                }
+                slides[index] = std::move(decoded.slides[0]);
+                sources[index].clean = false;
+                break;
+            case EditJournal::Op::InsertSlide:
+                if (index < 0 || index > count) {
+                    return false;
+                }
+                slides.insert(slides.begin() + index, Slide());
+                sources.insert(sources.begin() + index, SlideSource());
+                break;
+            case EditJournal::Op::RemoveSlide:
+                if (index < 0 || index >= count) {
+                    return false;
+                }
+                slides.erase(slides.begin() + index);
+                sources.erase(sources.begin() + index);
+                break;
+        }
+        modified = true;
+        return true;
+    });
+
+    if (currentSlideIndex >= static_cast<int>(slides.size())) {
+        currentSlideIndex = std::max(0, static_cast<int>(slides.size()) - 1);
+    }
+
+    if (recovered < 0) {
+        std::cerr << Color::Yellow().toAnsiFg() << "[WARN] " << Color::resetAnsi()
+                  << "Ignoring " << journal->getPath() << ": " << filename
+                  << " has changed since it was written." << std::endl;
+    } else if (recovered > 0) {
+        std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
+                  << "Recovered " << recovered << " unsaved edit(s) from: "
+                  << Color::Yellow().toAnsiFg() << journal->getPath() << Color::resetAnsi() << std::endl;
+    }
+    return recovered;
+}
+
+bool SlideShow::syncJournal() {
+    return !journal || journal->commit();
+}
+
+void SlideShow::discardJournal() {
+    if (journal) {
+        journal->discard();
+        journal.reset();
+    }
+}
+
+std::string SlideShow::getJournalPath() const {
+    return journal ? journal->getPath() : std::string();
+}
+
+void SlideShow::journalSlide(int slideNumber) {
+    if (journal) {
+        journal->append(EditJournal::Op::SetSlide, slideNumber, slides[slideNumber - 1].toJSON(false));
+    }
+}
+
+void SlideShow::setSourceFile(const std::string& path) {
+    std::error_code error;
+    sourceSize = std::filesystem::file_size(path, error);
+    if (!error) {
+        sourceTime = std::filesystem::last_write_time(path, error);
+    }
+    sourcePath = error ? std::string() : path;
+}
+
+bool SlideShow::isSourceUnchanged() const {
+    if (sourcePath.empty()) {
+        return false;
+    }
+    std::error_code error;
+    auto size = std::filesystem::file_size(sourcePath, error);
+    if (error || size != sourceSize) {
+        return false;
+    }
+    auto time = std::filesystem::last_write_time(sourcePath, error);
+    return !error && time == sourceTime;
+}
+
+bool SlideShow::writeTextFile(const std::string& path, std::vector<SlideSource>& written) const {
+    // Read the previous file in one go; unchanged slides are sliced out of it
+    std::string original;
+    if (isSourceUnchanged()) {
+        std::ifstream source(sourcePath, std::ios::binary);
+        original.resize(static_cast<size_t>(sourceSize));
+        source.read(&original[0], static_cast<std::streamsize>(original.size()));
+        if (!source) {
+            original.clear();
+        }
+    }
+
+    BufferedWriter out;
+    if (!out.open(path)) {
+        return false;
+    }
+
+    // Copied slides keep their bytes, so new lines must match the file's line endings
+    const char* newline = crlf ? "\r\n" : "\n";
+    size_t newlineLength = crlf ? 2 : 1;
+
+    std::string formatted;
+    written.assign(slides.size(), SlideSource());
+    for (size_t i = 0; i < slides.size(); ++i) {
+        // Slide separator between slides (not after last)
+        if (i > 0) {
+            out.write("---");
+            out.write(newline, newlineLength);
+        }
+
+        // Copy the slide's bytes when it is unchanged, otherwise format it
+        const SlideSource& range = sources[i];
+        const char* text = nullptr;
+        size_t length = 0;
+        if (range.clean && range.offset + range.length <= original.size()) {
+            text = original.data() + range.offset;
+            length = static_cast<size_t>(range.length);
+        } else {
+            formatted = slides[i].toFileFormat();
+            if (crlf) {
+                formatted = withCrlf(formatted);
+            }
+            text = formatted.data();
+            length = formatted.size();
+        }
+
+        written[i] = SlideSource{out.getBytesWritten(), length, true};
+        out.write(text, length);
+
+        // The file's last line may have had no newline
+        if (length > 0 && text[length - 1] != '\n' && i + 1 < slides.size()) {
+            out.write(newline, newlineLength);
+        }
+    }
+
+    return out.close();
+}
@@ -0,0 +1,292 @@
+#include "SvgWriter.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+// Opacity rounded to three decimals, as written in both inline and CSS form
+double opacityOf(const Color& color) {
+    return std::round(color.a * 1000.0 / 255.0) / 1000.0;
+}
+
+void appendInt(std::string& key, int value) {
+    char digits[12];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    key.append(digits, static_cast<size_t>(result.ptr - digits));
+}
+
+void appendColor(std::string& key, const Color& color) {
+    key += static_cast<char>(color.r);
+    key += static_cast<char>(color.g);
+    key += static_cast<char>(color.b);
+    key += static_cast<char>(color.a);
+}
+
+} // namespace
+
+// ============== SvgStyle ==============
+
+SvgStyle SvgStyle::fillOnly(const Color& fill) {
+    SvgStyle result;
+    result.hasFill = true;
+    result.fill = fill;
+    return result;
+}
+
+SvgStyle SvgStyle::strokeOnly(const Color& stroke, int strokeWidth) {
+    SvgStyle result;
+    result.hasStroke = true;
+    result.stroke = stroke;
+    result.strokeWidth = strokeWidth;
+    return result;
+}
+
+SvgStyle SvgStyle::fillAndStroke(const Color& fill, const Color& stroke, int strokeWidth) {
+    SvgStyle result = strokeOnly(stroke, strokeWidth);
+    result.hasFill = true;
+    result.fill = fill;
+    return result;
+}
+
+// ============== Elements & Attributes ==============
+
+void SvgWriter::attribute(const char* name, int value) {
+    write(' ');
+    write(name, std::strlen(name));
+    write("=\"");
+    writeInt(value);
+    write('"');
+}
+
+void SvgWriter::paint(const char* name, const Color& color) {
+    size_t nameLength = std::strlen(name);
+    write(' ');
+    write(name, nameLength);
+    write("=\"rgb(");
+    writeInt(color.r);
+    write(',');
+    writeInt(color.g);
+    write(',');
+    writeInt(color.b);
+    write(")\"");
+    if (!color.isOpaque()) {
+        write(' ');
+        write(name, nameLength);
+        write("-opacity=\"");
+        writeDouble(opacityOf(color));
+        write('"');
+    }
+}
+
+void SvgWriter::points(const std::vector<std::pair<int, int>>& vertices) {
+    write(" points=\"");
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        if (i > 0) write(' ');
+        writeInt(vertices[i].first);
+        write(',');
+        writeInt(vertices[i].second);
+    }
+    write('"');
+}
+
+void SvgWriter::style(const SvgStyle& paintStyle) {
+    if (optimized) {
+        styleKey(paintStyle, keyScratch);
+        auto it = sharedStyles.find(keyScratch);
+        if (it != sharedStyles.end() && it->second.id >= 0) {
+            write(" class=\"s");
+            writeInt(it->second.id);
+            write('"');
+            return;
+        }
+    }
+    writeInlineStyle(paintStyle);
+}
+
+void SvgWriter::polygon(const std::vector<std::pair<int, int>>& vertices) {
+    if (optimized && !vertices.empty()) {
+        polygonKey(vertices, keyScratch);
+        auto it = sharedPolygons.find(keyScratch);
+        if (it != sharedPolygons.end() && it->second.id >= 0) {
+            write("<use xlink:href=\"#g");
+            writeInt(it->second.id);
+            write('"');
+            attribute("x", vertices[0].first);
+            attribute("y", vertices[0].second);
+            return;
+        }
+    }
+    write("<polygon");
+    points(vertices);
+}
+
+void SvgWriter::writeInlineStyle(const SvgStyle& paintStyle) {
+    if (paintStyle.hasFill) paint("fill", paintStyle.fill);
+    if (paintStyle.hasStroke) paint("stroke", paintStyle.stroke);
+    if (paintStyle.strokeWidth >= 0) attribute("stroke-width", paintStyle.strokeWidth);
+}
+
+// ============== Optimized Mode ==============
+
+void SvgWriter::clearShared() {
+    sharedStyles.clear();
+    sharedPolygons.clear();
+    registrations = 0;
+}
+
+void SvgWriter::styleKey(const SvgStyle& paintStyle, std::string& key) {
+    key.clear();
+    if (paintStyle.hasFill) {
+        key += 'f';
+        appendColor(key, paintStyle.fill);
+    }
+    if (paintStyle.hasStroke) {
+        key += 's';
+        appendColor(key, paintStyle.stroke);
+    }
+    key += 'w';
+    appendInt(key, paintStyle.strokeWidth);
+}
+
+void SvgWriter::polygonKey(const std::vector<std::pair<int, int>>& vertices, std::string& key) {
+    key.clear();
+    int originX = vertices.empty() ? 0 : vertices[0].first;
+    int originY = vertices.empty() ? 0 : vertices[0].second;
+    for (const auto& vertex : vertices) {
+        appendInt(key, vertex.first - originX);
+        key += ',';
+        appendInt(key, vertex.second - originY);
+        key += ' ';
+    }
+}
+
+void SvgWriter::countStyle(const SvgStyle& paintStyle) {
+    styleKey(paintStyle, keyScratch);
+    SharedEntry& entry = sharedStyles[keyScratch];
+    if (entry.uses++ == 0) {
+        entry.firstUse = registrations++;
+        entry.paintStyle = paintStyle;
+    }
+}
+
+bool SvgWriter::hasSharedPolygons() const {
+    for (const auto& pair : sharedPolygons) {
+        if (pair.second.uses > 1) return true;
+    }
+    return false;
+}
+
+void SvgWriter::countPolygon(const std::vector<std::pair<int, int>>& vertices) {
+    if (vertices.empty()) return;
+    polygonKey(vertices, keyScratch);
+    SharedEntry& entry = sharedPolygons[keyScratch];
+    if (entry.uses++ == 0) {
+        entry.firstUse = registrations++;
+    }
+}
+
+void SvgWriter::writeCssColor(const Color& color) {
+    static const char kHex[] = "0123456789abcdef";
+    write('#');
+    // #rgb when every channel repeats its digit, #rrggbb otherwise
+    if (color.r % 17 == 0 && color.g % 17 == 0 && color.b % 17 == 0) {
+        write(kHex[color.r / 17]);
+        write(kHex[color.g / 17]);
+        write(kHex[color.b / 17]);
+        return;
+    }
+    for (uint8_t channel : {color.r, color.g, color.b}) {
+        write(kHex[channel >> 4]);
+        write(kHex[channel & 15]);
+    }
+}
+
+void SvgWriter::writeCssRule(int id, const SvgStyle& paintStyle) {
+    write(".s");
+    writeInt(id);
+    write('{');
+    bool first = true;
+    if (paintStyle.hasFill) {
+        write("fill:");
+        writeCssColor(paintStyle.fill);
+        if (!paintStyle.fill.isOpaque()) {
+            write(";fill-opacity:");
+            writeDouble(opacityOf(paintStyle.fill));
+        }
+        first = false;
+    }
+    if (paintStyle.hasStroke) {
+        if (!first) write(';');
+        write("stroke:");
+        writeCssColor(paintStyle.stroke);
+        if (!paintStyle.stroke.isOpaque()) {
+            write(";stroke-opacity:");
+            writeDouble(opacityOf(paintStyle.stroke));
+        }
+        first = false;
+    }
+    if (paintStyle.strokeWidth >= 0) {
+        if (!first) write(';');
+        write("stroke-width:");
+        writeInt(paintStyle.strokeWidth);
+    }
+    write('}');
+}
+
+std::vector<SvgWriter::SharedMap::value_type*> SvgWriter::repeatedEntries(SharedMap& entries) {
+    std::vector<SharedMap::value_type*> repeated;
+    for (auto& pair : entries) {
+        if (pair.second.uses > 1) repeated.push_back(&pair);
+    }
+    std::sort(repeated.begin(), repeated.end(),
+              [](const SharedMap::value_type* a, const SharedMap::value_type* b) {
+                  return a->second.firstUse < b->second.firstUse;
+              });
+    return repeated;
+}
+
+void SvgWriter::writeSharedDefinitions() {
+    auto styles = repeatedEntries(sharedStyles);
+    auto polygons = repeatedEntries(sharedPolygons);
+
+    if (!styles.empty()) {
+        write("<style>");
+        for (size_t i = 0; i < styles.size(); ++i) {
+            styles[i]->second.id = static_cast<int>(i);
+            writeCssRule(styles[i]->second.id, styles[i]->second.paintStyle);
+        }
+        write("</style>\n");
+    }
+
+    if (!polygons.empty()) {
+        write("<defs>");
+        for (size_t i = 0; i < polygons.size(); ++i) {
+            polygons[i]->second.id = static_cast<int>(i);
+            write("<polygon id=\"g");
+            writeInt(polygons[i]->second.id);
+            // The key is already the relative points list, with a trailing space
+            const std::string& outline = polygons[i]->first;
+            write("\" points=\"");
+            write(outline.data(), outline.size() - 1);
+            write("\"/>");
+        }
+        write("</defs>\n");
+    }
+}
+
+std::string SvgWriter::describeReduction(uint64_t plainBytes, uint64_t optimizedBytes) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    if (optimizedBytes >= 1024) {
+        oss << optimizedBytes / 1024.0 << " KB, ";
+    } else {
+        oss << optimizedBytes << " bytes, ";
+    }
+    double saved = plainBytes > 0 ? 100.0 * (1.0 - static_cast<double>(optimizedBytes) / plainBytes) : 0.0;
+    oss << std::setprecision(0) << std::abs(saved) << (saved < 0 ? "% larger" : "% smaller") << " than plain SVG";
+    return oss.str();
+}
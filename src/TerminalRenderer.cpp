@@ -0,0 +1,166 @@
+#include "TerminalRenderer.h"
+#include <cstdio>
+#include <iostream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Terminal rows used by the pinned area: header, top border, cells, bottom border
+constexpr int kHeaderRow = 1;
+constexpr int kFirstCellRow = 3;
+
+const char* const kBlock = "█";  // Full block
+
+Color borderColor() {
+    return Color(100, 100, 120);
+}
+
+void appendMoveTo(std::string& out, int row, int column) {
+    out += "\033[";
+    out += std::to_string(row);
+    out += ';';
+    out += std::to_string(column);
+    out += 'H';
+}
+
+/**
+ * @brief Appends a cell glyph, switching color only when it differs from the last one
+ */
+void appendCell(std::string& out, bool filled, const Color& color, bool& haveColor, Color& current) {
+    if (!filled) {
+        out += ' ';
+        return;
+    }
+    if (!haveColor || !(current == color)) {
+        color.appendAnsiFg(out);
+        current = color;
+        haveColor = true;
+    }
+    out += kBlock;
+}
+
+} // namespace
+
+TerminalRenderer::TerminalRenderer()
+    : columns(0), rows(0), active(false),
+      lastFrameBytes(0), lastChangedCells(0), totalBytes(0), frameCount(0) {}
+
+size_t TerminalRenderer::present(const Canvas& canvas, const std::string& headerText) {
+    std::vector<Cell> next;
+    sampleCells(canvas, next);
+    
+    std::string out;
+    bool sameSize = canvas.getAsciiWidth() == columns && canvas.getAsciiHeight() == rows;
+    if (active && sameSize) {
+        lastChangedCells = writeChangedCells(next, headerText, out);
+    } else {
+        columns = canvas.getAsciiWidth();
+        rows = canvas.getAsciiHeight();
+        header = headerText;
+        writeFullFrame(next, out);
+        lastChangedCells = columns * rows;
+        active = true;
+    }
+    cells.swap(next);
+    header = headerText;
+    
+    std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
+    std::cout.flush();
+    
+    lastFrameBytes = out.size();
+    totalBytes += out.size();
+    ++frameCount;
+    return out.size();
+}
+
+void TerminalRenderer::release() {
+    if (!active) return;
+    // Reset the scroll region without losing the cursor position
+    std::cout << "\0337\033[r\0338" << std::flush;
+    active = false;
+    cells.clear();
+}
+
+bool TerminalRenderer::isInteractive() {
+#ifdef _WIN32
+    return _isatty(_fileno(stdout)) != 0;
+#else
+    return isatty(fileno(stdout)) != 0;
+#endif
+}
+
+void TerminalRenderer::sampleCells(const Canvas& canvas, std::vector<Cell>& out) const {
+    int width = canvas.getAsciiWidth();
+    int height = canvas.getAsciiHeight();
+    out.resize(static_cast<size_t>(width) * height);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            Cell& cell = out[static_cast<size_t>(y) * width + x];
+            cell.filled = canvas.sampleAsciiCell(x, y, cell.color);
+        }
+    }
+}
+
+void TerminalRenderer::writeFullFrame(const std::vector<Cell>& next, std::string& out) const {
+    std::string border = borderColor().toAnsiFg();
+    std::string edge = "+" + std::string(columns, '-') + "+";
+    
+    // Clear everything, including a scroll region left by a previous frame
+    out += "\033[r\033[2J\033[H";
+    out += header;
+    out += Color::resetAnsi() + "\n";
+    out += border + edge + "\n";
+    for (int y = 0; y < rows; ++y) {
+        out += border + "|";
+        bool haveColor = false;
+        Color current;
+        for (int x = 0; x < columns; ++x) {
+            const Cell& cell = next[static_cast<size_t>(y) * columns + x];
+            appendCell(out, cell.filled, cell.color, haveColor, current);
+        }
+        out += border + "|\n";
+    }
+    out += border + edge + Color::resetAnsi();
+    
+    // Keep later output scrolling below the preview
+    int firstFreeRow = kFirstCellRow + rows + 1;
+    out += "\033[" + std::to_string(firstFreeRow) + "r";
+    appendMoveTo(out, firstFreeRow, 1);
+}
+
+int TerminalRenderer::writeChangedCells(const std::vector<Cell>& next, const std::string& headerText,
+                                        std::string& out) const {
+    out += "\0337";  // Save cursor
+    if (headerText != header) {
+        appendMoveTo(out, kHeaderRow, 1);
+        out += "\033[2K";
+        out += headerText;
+    }
+    
+    int changed = 0;
+    bool haveColor = false;
+    Color current;
+    for (int y = 0; y < rows; ++y) {
+        // Cursor is already in place while consecutive cells change
+        int cursorX = -1;
+        for (int x = 0; x < columns; ++x) {
+            size_t i = static_cast<size_t>(y) * columns + x;
+            if (next[i] == cells[i]) continue;
+            if (cursorX != x) {
+                appendMoveTo(out, kFirstCellRow + y, x + 2);
+            }
+            appendCell(out, next[i].filled, next[i].color, haveColor, current);
+            cursorX = x + 1;
+            ++changed;
+        }
+    }
+    
+    out += Color::resetAnsi();
+    out += "\0338";  // Restore cursor
+    return changed;
+}
@@ -0,0 +1,156 @@
+#include "Tracer.h"
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+// Bounds memory in long server sessions; later spans are dropped
+constexpr size_t kMaxEvents = 1000000;
+
+struct TraceEvent {
+    const char* category;
+    const char* name;
+    uint32_t threadId;
+    double startUs;
+    double durationUs;
+    std::string args;
+};
+
+std::atomic<bool> tracingEnabled(false);
+std::mutex traceMutex;
+std::vector<TraceEvent> traceEvents;
+std::map<uint32_t, std::string> threadNames;
+std::chrono::steady_clock::time_point traceStart = std::chrono::steady_clock::now();
+std::atomic<uint32_t> nextThreadId(1);
+
+// Small sequential ids keep the viewer's track order stable
+uint32_t currentThreadId() {
+    thread_local uint32_t id = nextThreadId.fetch_add(1);
+    return id;
+}
+
+double microsecondsSince(std::chrono::steady_clock::time_point from,
+                         std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<double, std::micro>(to - from).count();
+}
+
+void appendEscaped(std::string& out, const std::string& text) {
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out += ' ';
+                } else {
+                    out += c;
+                }
+        }
+    }
+}
+
+} // namespace
+
+// ============== Span ==============
+
+Tracer::Span::Span(const char* category, const char* name)
+    : category(category), name(name), active(Tracer::isEnabled()) {
+    if (active) start = std::chrono::steady_clock::now();
+}
+
+Tracer::Span::~Span() {
+    if (!active) return;
+    auto end = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(traceMutex);
+    // A span that outlived stop()/start() would land outside the new trace
+    if (start < traceStart || traceEvents.size() >= kMaxEvents) return;
+    traceEvents.push_back({category, name, currentThreadId(),
+                           microsecondsSince(traceStart, start),
+                           microsecondsSince(start, end), std::move(args)});
+}
+
+void Tracer::Span::arg(const char* key, int64_t value) {
+    if (!active) return;
+    if (!args.empty()) args += ',';
+    args += '"';
+    args += key;
+    args += "\":";
+    args += std::to_string(value);
+}
+
+void Tracer::Span::arg(const char* key, const std::string& value) {
+    if (!active) return;
+    if (!args.empty()) args += ',';
+    args += '"';
+    args += key;
+    args += "\":\"";
+    appendEscaped(args, value);
+    args += '"';
+}
+
+// ============== Recording ==============
+
+void Tracer::start() {
+    std::lock_guard<std::mutex> lock(traceMutex);
+    traceEvents.clear();
+    traceStart = std::chrono::steady_clock::now();
+    tracingEnabled.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::stop() {
+    tracingEnabled.store(false, std::memory_order_relaxed);
+}
+
+bool Tracer::isEnabled() {
+    return tracingEnabled.load(std::memory_order_relaxed);
+}
+
+void Tracer::setThreadName(const std::string& name) {
+    std::lock_guard<std::mutex> lock(traceMutex);
+    threadNames[currentThreadId()] = name;
+}
+
+size_t Tracer::getEventCount() {
+    std::lock_guard<std::mutex> lock(traceMutex);
+    return traceEvents.size();
+}
+
+bool Tracer::writeToFile(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(traceMutex);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"slideshow\"}}";
+
+    std::string text;
+    for (const auto& pair : threadNames) {
+        text.clear();
+        appendEscaped(text, pair.second);
+        file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << pair.first
+             << ",\"args\":{\"name\":\"" << text << "\"}}";
+    }
+
+    file << std::fixed << std::setprecision(3);
+    for (const TraceEvent& event : traceEvents) {
+        file << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category
+             << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId
+             << ",\"ts\":" << event.startUs << ",\"dur\":" << event.durationUs;
+        if (!event.args.empty()) {
+            file << ",\"args\":{" << event.args << "}";
+        }
+        file << "}";
+    }
+    file << "\n]}\n";
+    return file.good();
+}
@@ -1,8 +1,10 @@
 #include "UndoManager.h"
+#include "Profiler.h"
 
 UndoManager::UndoManager(size_t maxSize) : maxHistorySize(maxSize) {}
 
 void UndoManager::saveState(int slideIndex, const Slide& slide, const std::string& actionDescription) {
+    SLIDESHOW_PROFILE_SCOPE(UNDO_SAVE_STATE);
     // Clear redo stack when new action is performed
     clearRedo();
     
@@ -40,6 +42,7 @@ std::string UndoManager::getRedoDescription() const {
 }
 
 SlideSnapshot* UndoManager::undo(const Slide& currentSlide) {
+    SLIDESHOW_PROFILE_SCOPE(UNDO);
     if (!canUndo()) {
         return nullptr;
     }
@@ -57,6 +60,7 @@ SlideSnapshot* UndoManager::undo(const Slide& currentSlide) {
 }
 
 SlideSnapshot* UndoManager::redo(const Slide& currentSlide) {
+    SLIDESHOW_PROFILE_SCOPE(REDO);
     if (!canRedo()) {
         return nullptr;
     }
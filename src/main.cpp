@@ -6,13 +6,21 @@
 #include "ShapeFactory.h"
 #include "Color.h"
 #include "Canvas.h"
+#include "SvgWriter.h"
 #include "UndoManager.h"
+#include "Profiler.h"
+#include "Tracer.h"
+#include "TerminalRenderer.h"
+#include "SlideServer.h"
 #include <iostream>
 #include <fstream>
+#include <cstdio>
 #include <vector>
 #include <map>
 #include <memory>
 #include <iomanip>
+#include <cctype>
+#include <cmath>
 
 // ============== Display Mode ==============
 enum DisplayMode {
@@ -22,6 +30,63 @@ enum DisplayMode {
 
 static DisplayMode currentDisplayMode = MODE_TEXT;
 
+// Pinned preview used by visual mode when stdout is a terminal
+static TerminalRenderer terminalRenderer;
+
+// Headless batch mode: no banner, prompts or automatic redraws
+static bool batchMode = false;
+
+// Source of commands and prompt answers (std::cin, or the script in batch mode)
+static std::istream* commandInput = &std::cin;
+
+// ============== Batch Output Buffer ==============
+/**
+ * @brief Stream buffer that collects std::cout output in large blocks
+ * Flushes requested by std::endl are ignored, so a batch run writes to
+ * stdout once per block instead of once per line.
+ */
+class BatchOutputBuffer : public std::streambuf {
+private:
+    std::vector<char> buffer;
+    std::FILE* out;
+
+public:
+    explicit BatchOutputBuffer(std::FILE* out, size_t capacity = 64 * 1024)
+        : buffer(capacity), out(out) {
+        setp(buffer.data(), buffer.data() + buffer.size());
+    }
+
+    ~BatchOutputBuffer() override { flushAll(); }
+
+    /**
+     * @brief Writes everything buffered so far to the underlying file
+     */
+    void flushAll() {
+        std::ptrdiff_t pending = pptr() - pbase();
+        if (pending > 0) {
+            std::fwrite(pbase(), 1, static_cast<size_t>(pending), out);
+        }
+        std::fflush(out);
+        setp(buffer.data(), buffer.data() + buffer.size());
+    }
+
+protected:
+    int_type overflow(int_type ch) override {
+        std::ptrdiff_t pending = pptr() - pbase();
+        if (pending > 0) {
+            std::fwrite(pbase(), 1, static_cast<size_t>(pending), out);
+        }
+        setp(buffer.data(), buffer.data() + buffer.size());
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    int sync() override { return 0; }
+};
+
 // ============== Application Banner ==============
 void displayBanner() {
     std::cout << Color::Cyan().toAnsiFg();
@@ -60,10 +125,14 @@ void displayHelp() {
     std::cout << Color::Cyan().toAnsiFg() << "╠═══════════════════════════════════════════════════════════════╣" << Color::resetAnsi() << std::endl;
     std::cout << Color::Cyan().toAnsiFg() << "║" << Color::Green().toAnsiFg() << " SHAPE MANIPULATION                                            " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
     std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "   add (a)           - Add a new shape (interactive)           " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
-    std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "   delete (del) <n>  - Delete shape by index                   " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
+    std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "   delete (del) <s>  - Delete shapes (3, 1,4-6, all, circle)   " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
     std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "   edit (e) <n>      - Edit shape properties (interactive)     " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
     std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "   list (ls)         - List all shapes on current slide        " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
     std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "   clear             - Remove all shapes from current slide    " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
+    std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "   move (mv) <s> x y - Move shapes by an offset                " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
+    std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "   scale <s> <pct>   - Resize shapes, e.g. scale all 150       " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
+    std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "   recolor <s> <c>   - Set fill (and border) color of shapes   " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
+    std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "   duplicate (dup) <s> - Copy shapes, offset by 10 (or dx dy)  " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
     
     std::cout << Color::Cyan().toAnsiFg() << "╠═══════════════════════════════════════════════════════════════╣" << Color::resetAnsi() << std::endl;
     std::cout << Color::Cyan().toAnsiFg() << "║" << Color::Green().toAnsiFg() << " SLIDE MANIPULATION                                            " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
@@ -79,7 +148,10 @@ void displayHelp() {
     std::cout << Color::Cyan().toAnsiFg() << "║" << Color::Green().toAnsiFg() << " EXPORT                                                        " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
     std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "   export <file>     - Export current slide to BMP/SVG         " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
     std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "   exportall <pre>   - Export all slides (prefix_1.bmp, etc)   " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
+    std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "     ... noaa        - Export BMP without anti-aliasing        " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
+    std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "     ... opt         - Smaller SVG with shared styles & shapes " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
     std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "   exportjson <file> - Export slide/slideshow to JSON          " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
+    std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "     ... compact     - Export JSON without indentation         " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
     
     std::cout << Color::Cyan().toAnsiFg() << "╠═══════════════════════════════════════════════════════════════╣" << Color::resetAnsi() << std::endl;
     std::cout << Color::Cyan().toAnsiFg() << "║" << Color::Green().toAnsiFg() << " FILE OPERATIONS                                               " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
@@ -97,6 +169,9 @@ void displayHelp() {
     std::cout << Color::Cyan().toAnsiFg() << "║" << Color::Green().toAnsiFg() << " UTILITIES                                                     " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
     std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "   shapes            - Show available shape types              " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
     std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "   colors            - Show available colors                   " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
+    std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "   stats             - Show profiling counts and latencies     " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
+    std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "     on|off|reset    - Start, stop or clear profiling          " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
+    std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "     save <file>     - Write profiling summary as CSV          " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
     std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "   help (h)          - Display this help message               " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
     std::cout << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << "   exit (q)          - Exit the program                        " << Color::Cyan().toAnsiFg() << "║" << Color::resetAnsi() << std::endl;
     
@@ -146,72 +221,6 @@ void displayAvailableColors() {
     std::cout << Color::Cyan().toAnsiFg() << "  ═════════════════════════════════════════" << Color::resetAnsi() << "\n" << std::endl;
 }
 
-// ============== Load Presentation ==============
-std::unique_ptr<SlideShow> loadPresentation(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
-                  << "Failed to open file: " << filename << std::endl;
-        return nullptr;
-    }
-
-    auto slideshow = std::make_unique<SlideShow>(filename);
-    Slide currentSlide;
-    std::string line;
-    bool hasContent = false;
-
-    while (std::getline(file, line)) {
-        std::string trimmedLine = Tokenizer::trim(line);
-        
-        // Check for slide separator
-        if (trimmedLine == "---") {
-            slideshow->addSlide(currentSlide);
-            currentSlide = Slide();
-            hasContent = false;
-            continue;
-        }
-        
-        // Skip empty lines
-        if (trimmedLine.empty()) {
-            continue;
-        }
-        
-        // Parse shape using factory
-        std::vector<std::string> tokens = Tokenizer::split(trimmedLine, ',');
-        if (tokens.size() >= 3) {
-            auto shape = ShapeFactory::createFromLine(tokens);
-            if (shape) {
-                currentSlide.addShape(std::shared_ptr<Shape>(shape.release()));
-                hasContent = true;
-            } else {
-                std::cerr << Color::Yellow().toAnsiFg() << "[WARN] " << Color::resetAnsi()
-                          << "Unknown shape in " << filename << ": " << line << std::endl;
-            }
-        } else {
-            std::cerr << Color::Yellow().toAnsiFg() << "[WARN] " << Color::resetAnsi()
-                      << "Invalid line format in " << filename << ": " << line << std::endl;
-        }
-    }
-    
-    // Add the last slide if it has content
-    if (hasContent || currentSlide.getShapeCount() > 0) {
-        slideshow->addSlide(currentSlide);
-    }
-
-    file.close();
-    
-    if (slideshow->isEmpty()) {
-        std::cerr << Color::Yellow().toAnsiFg() << "[WARN] " << Color::resetAnsi()
-                  << "No slides found in: " << filename << std::endl;
-    } else {
-        std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
-                  << "Loaded " << slideshow->getTotalSlides() << " slide(s) from: " 
-                  << Color::Yellow().toAnsiFg() << filename << Color::resetAnsi() << std::endl;
-    }
-
-    return slideshow;
-}
-
 // ============== Display Prompt ==============
 void displayPrompt(const SlideShow* currentShow) {
     if (currentShow && !currentShow->isEmpty()) {
@@ -232,64 +241,91 @@ void displayPrompt(const SlideShow* currentShow) {
 // ============== Display Current Slide ==============
 void displayCurrentSlide(SlideShow* slideshow) {
     if (currentDisplayMode == MODE_VISUAL) {
-        slideshow->showVisual();
+        if (!batchMode && TerminalRenderer::isInteractive()) {
+            slideshow->showVisual(terminalRenderer);
+        } else {
+            slideshow->showVisual();
+        }
     } else {
         slideshow->show();
     }
 }
 
+// ============== Refresh Current Slide ==============
+// Redraw after a command changed the view; batch scripts ask with 'show'
+void refreshCurrentSlide(SlideShow* slideshow) {
+    if (!batchMode) {
+        displayCurrentSlide(slideshow);
+    }
+}
+
+// ============== Input Prompt ==============
+void displayInputPrompt(const std::string& text) {
+    if (!batchMode) {
+        std::cout << Color::Yellow().toAnsiFg() << text << Color::resetAnsi();
+    }
+}
+
 // ============== Interactive Add Shape ==============
-void interactiveAddShape(Slide* slide) {
+/**
+ * @brief Asks for a shape and adds it to the slide
+ * @param changed Set to true only if a shape was added
+ * @return False on invalid input; cancelling still succeeds
+ */
+bool interactiveAddShape(Slide* slide, bool& changed) {
+    changed = false;
     std::vector<std::string> shapes = ShapeFactory::getAvailableShapes();
     
-    std::cout << Color::Cyan().toAnsiFg() << "\n  ═══════════ Add New Shape ═══════════" << Color::resetAnsi() << std::endl;
-    
-    for (size_t i = 0; i < shapes.size(); ++i) {
-        Color c = ShapeFactory::getDefaultColor(shapes[i]);
-        ShapeFactory::ShapeParams params;
-        params.fillColor = c;
-        auto tempShape = ShapeFactory::create(shapes[i], params);
-        std::string icon = tempShape ? tempShape->getAsciiIcon() : "?";
+    if (!batchMode) {
+        std::cout << Color::Cyan().toAnsiFg() << "\n  ═══════════ Add New Shape ═══════════" << Color::resetAnsi() << std::endl;
         
-        std::cout << "  " << Color::Yellow().toAnsiFg() << std::setw(2) << (i + 1) << ". "
-                  << Color::resetAnsi() << c.toAnsiFg() << icon << " "
-                  << Color::resetAnsi() << shapes[i] << std::endl;
+        for (size_t i = 0; i < shapes.size(); ++i) {
+            Color c = ShapeFactory::getDefaultColor(shapes[i]);
+            ShapeFactory::ShapeParams params;
+            params.fillColor = c;
+            auto tempShape = ShapeFactory::create(shapes[i], params);
+            std::string icon = tempShape ? tempShape->getAsciiIcon() : "?";
+            
+            std::cout << "  " << Color::Yellow().toAnsiFg() << std::setw(2) << (i + 1) << ". "
+                      << Color::resetAnsi() << c.toAnsiFg() << icon << " "
+                      << Color::resetAnsi() << shapes[i] << std::endl;
+        }
+        std::cout << "  " << Color::Gray().toAnsiFg() << (shapes.size() + 1) << ". Cancel" << Color::resetAnsi() << std::endl;
+        std::cout << Color::Cyan().toAnsiFg() << "  ═════════════════════════════════════════" << Color::resetAnsi() << std::endl;
     }
-    std::cout << "  " << Color::Gray().toAnsiFg() << (shapes.size() + 1) << ". Cancel" << Color::resetAnsi() << std::endl;
-    std::cout << Color::Cyan().toAnsiFg() << "  ═════════════════════════════════════════" << Color::resetAnsi() << std::endl;
     
-    std::cout << Color::Yellow().toAnsiFg() << "  Enter shape number: " << Color::resetAnsi();
+    displayInputPrompt("  Enter shape number: ");
     std::string input;
-    if (!std::getline(std::cin, input)) return;
+    if (!std::getline(*commandInput, input)) return false;
     
     int selection;
     try {
         selection = std::stoi(Tokenizer::trim(input));
     } catch (...) {
         std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi() << "Invalid selection." << std::endl;
-        return;
+        return false;
     }
     
     if (selection == static_cast<int>(shapes.size() + 1) || selection < 1) {
         std::cout << Color::Gray().toAnsiFg() << "[INFO] " << Color::resetAnsi() << "Cancelled." << std::endl;
-        return;
+        return true;
     }
     
     if (selection > static_cast<int>(shapes.size())) {
         std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi() << "Invalid selection." << std::endl;
-        return;
+        return false;
     }
     
     std::string shapeName = shapes[selection - 1];
     
     // Get position
-    std::cout << Color::Yellow().toAnsiFg() << "  Enter position (x y): " << Color::resetAnsi();
-    if (!std::getline(std::cin, input)) return;
+    displayInputPrompt("  Enter position (x y): ");
+    if (!std::getline(*commandInput, input)) return false;
     
     std::vector<std::string> posTokens = CommandParser::tokenize(input);
     if (posTokens.size() < 2) {
         std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi() << "Please enter x and y coordinates." << std::endl;
-        return;
+        return false;
     }
     
     int x, y;
@@ -298,12 +334,12 @@ void interactiveAddShape(Slide* slide) {
         y = std::stoi(posTokens[1]);
     } catch (...) {
         std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi() << "Invalid coordinates." << std::endl;
-        return;
+        return false;
     }
     
     // Get size (optional)
-    std::cout << Color::Yellow().toAnsiFg() << "  Enter size (width height) or press Enter for default: " << Color::resetAnsi();
-    if (!std::getline(std::cin, input)) return;
+    displayInputPrompt("  Enter size (width height) or press Enter for default: ");
+    if (!std::getline(*commandInput, input)) return false;
     
     int width = 40, height = 30;
     std::vector<std::string> sizeTokens = CommandParser::tokenize(input);
@@ -322,20 +358,22 @@ void interactiveAddShape(Slide* slide) {
     
     // Get color (with picker)
     std::vector<std::string> colors = Color::getAvailableColors();
-    std::cout << Color::Cyan().toAnsiFg() << "\n  ═══════════ Choose Color ═══════════" << Color::resetAnsi() << std::endl;
-    
-    for (size_t i = 0; i < colors.size(); ++i) {
-        Color c(colors[i]);
-        std::cout << "  " << Color::Yellow().toAnsiFg() << std::setw(2) << (i + 1) << ". "
-                  << Color::resetAnsi() << c.toAnsiFg() << "████ " 
-                  << Color::resetAnsi() << colors[i] << std::endl;
+    if (!batchMode) {
+        std::cout << Color::Cyan().toAnsiFg() << "\n  ═══════════ Choose Color ═══════════" << Color::resetAnsi() << std::endl;
+        
+        for (size_t i = 0; i < colors.size(); ++i) {
+            Color c(colors[i]);
+            std::cout << "  " << Color::Yellow().toAnsiFg() << std::setw(2) << (i + 1) << ". "
+                      << Color::resetAnsi() << c.toAnsiFg() << "████ " 
+                      << Color::resetAnsi() << colors[i] << std::endl;
+        }
+        std::cout << "  " << Color::Gray().toAnsiFg() << (colors.size() + 1) << ". Default (" 
+                  << ShapeFactory::getDefaultColor(shapeName).getName() << ")" << Color::resetAnsi() << std::endl;
+        std::cout << Color::Cyan().toAnsiFg() << "  ═════════════════════════════════════════" << Color::resetAnsi() << std::endl;
     }
-    std::cout << "  " << Color::Gray().toAnsiFg() << (colors.size() + 1) << ". Default (" 
-              << ShapeFactory::getDefaultColor(shapeName).getName() << ")" << Color::resetAnsi() << std::endl;
-    std::cout << Color::Cyan().toAnsiFg() << "  ═════════════════════════════════════════" << Color::resetAnsi() << std::endl;
     
-    std::cout << Color::Yellow().toAnsiFg() << "  Enter color number or name: " << Color::resetAnsi();
-    if (!std::getline(std::cin, input)) return;
+    displayInputPrompt("  Enter color number or name: ");
+    if (!std::getline(*commandInput, input)) return false;
     
     Color fillColor = ShapeFactory::getDefaultColor(shapeName);
     std::string colorInput = Tokenizer::trim(input);
@@ -364,79 +402,95 @@ void interactiveAddShape(Slide* slide) {
     auto shape = ShapeFactory::create(shapeName, params);
     if (shape) {
         slide->addShape(std::shared_ptr<Shape>(shape.release()));
+        changed = true;
         std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
                   << "Added " << fillColor.toAnsiFg() << shapeName << Color::resetAnsi()
                   << " at (" << x << ", " << y << ")" << std::endl;
-    } else {
-        std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi() << "Failed to create shape." << std::endl;
+        return true;
     }
+    
+    std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi() << "Failed to create shape." << std::endl;
+    return false;
 }
 
 // ============== Interactive Edit Shape ==============
-void interactiveEditShape(Slide* slide, size_t index) {
+/**
+ * @brief Asks for a property of the shape and changes it
+ * @param changed Set to true only if the shape was changed
+ * @return False on invalid input; cancelling still succeeds
+ */
+bool interactiveEditShape(Slide* slide, size_t index, bool& changed) {
+    changed = false;
     auto shape = slide->getShape(index);
     if (!shape) {
         std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi() << "Invalid shape index." << std::endl;
-        return;
+        return false;
     }
     
-    std::cout << Color::Cyan().toAnsiFg() << "\n  ═══════════ Edit " << shape->getName() << " ═══════════" << Color::resetAnsi() << std::endl;
-    std::cout << "  Current: (" << shape->getX() << ", " << shape->getY() << ") "
-              << "[" << shape->getWidth() << "x" << shape->getHeight() << "] "
-              << shape->getFillColor().getName() << std::endl;
-    
-    std::cout << Color::Yellow().toAnsiFg() << "\n  1. " << Color::resetAnsi() << "Change position" << std::endl;
-    std::cout << Color::Yellow().toAnsiFg() << "  2. " << Color::resetAnsi() << "Change size" << std::endl;
-    std::cout << Color::Yellow().toAnsiFg() << "  3. " << Color::resetAnsi() << "Change color" << std::endl;
-    std::cout << Color::Yellow().toAnsiFg() << "  4. " << Color::resetAnsi() << "Cancel" << std::endl;
+    if (!batchMode) {
+        std::cout << Color::Cyan().toAnsiFg() << "\n  ═══════════ Edit " << shape->getName() << " ═══════════" << Color::resetAnsi() << std::endl;
+        std::cout << "  Current: (" << shape->getX() << ", " << shape->getY() << ") "
+                  << "[" << shape->getWidth() << "x" << shape->getHeight() << "] "
+                  << shape->getFillColor().getName() << std::endl;
+        
+        std::cout << Color::Yellow().toAnsiFg() << "\n  1. " << Color::resetAnsi() << "Change position" << std::endl;
+        std::cout << Color::Yellow().toAnsiFg() << "  2. " << Color::resetAnsi() << "Change size" << std::endl;
+        std::cout << Color::Yellow().toAnsiFg() << "  3. " << Color::resetAnsi() << "Change color" << std::endl;
+        std::cout << Color::Yellow().toAnsiFg() << "  4. " << Color::resetAnsi() << "Cancel" << std::endl;
+    }
     
-    std::cout << Color::Yellow().toAnsiFg() << "\n  Enter option: " << Color::resetAnsi();
+    displayInputPrompt("\n  Enter option: ");
     std::string input;
-    if (!std::getline(std::cin, input)) return;
+    if (!std::getline(*commandInput, input)) return false;
     
     int option;
     try {
         option = std::stoi(Tokenizer::trim(input));
     } catch (...) {
         std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi() << "Invalid option." << std::endl;
-        return;
+        return false;
     }
     
     switch (option) {
         case 1: {
-            std::cout << Color::Yellow().toAnsiFg() << "  New position (x y): " << Color::resetAnsi();
-            if (!std::getline(std::cin, input)) return;
+            displayInputPrompt("  New position (x y): ");
+            if (!std::getline(*commandInput, input)) return false;
             std::vector<std::string> tokens = CommandParser::tokenize(input);
             if (tokens.size() >= 2) {
                 try {
                     shape->setPosition(std::stoi(tokens[0]), std::stoi(tokens[1]));
+                    changed = true;
                     std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi() << "Position updated." << std::endl;
                 } catch (...) {
                     std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi() << "Invalid coordinates." << std::endl;
+                    return false;
                 }
             }
             break;
         }
         case 2: {
-            std::cout << Color::Yellow().toAnsiFg() << "  New size (width height): " << Color::resetAnsi();
-            if (!std::getline(std::cin, input)) return;
+            displayInputPrompt("  New size (width height): ");
+            if (!std::getline(*commandInput, input)) return false;
             std::vector<std::string> tokens = CommandParser::tokenize(input);
             if (tokens.size() >= 2) {
                 try {
                     shape->setSize(std::stoi(tokens[0]), std::stoi(tokens[1]));
+                    changed = true;
                     std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi() << "Size updated." << std::endl;
                 } catch (...) {
                     std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi() << "Invalid size." << std::endl;
+                    return false;
                 }
             }
             break;
         }
         case 3: {
-            std::cout << Color::Yellow().toAnsiFg() << "  New color name: " << Color::resetAnsi();
-            if (!std::getline(std::cin, input)) return;
+            displayInputPrompt("  New color name: ");
+            if (!std::getline(*commandInput, input)) return false;
             input = Tokenizer::trim(input);
             if (!input.empty()) {
                 shape->setFillColor(Color(input));
+                changed = true;
                 std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi() << "Color updated to "
                           << shape->getFillColor().toAnsiFg() << shape->getFillColor().getName() 
                           << Color::resetAnsi() << std::endl;
@@ -446,6 +500,99 @@ void interactiveEditShape(Slide* slide, size_t index) {
         default:
             std::cout << Color::Gray().toAnsiFg() << "[INFO] " << Color::resetAnsi() << "Cancelled." << std::endl;
     }
+    return true;
+}
+
+// ============== Export Options ==============
+/**
+ * @brief Checks the words after the file name or prefix for an option such as "noaa"
+ */
+bool hasExportOption(const std::vector<std::string>& args, const std::string& option) {
+    for (size_t i = 1; i < args.size(); ++i) {
+        if (Tokenizer::toLower(args[i]) == option) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ============== Shape Selections ==============
+/**
+ * @brief Parses a shape selection such as "3", "1,4-6", "all" or a shape type ("circle")
+ * Numbers are 1-based on the command line; the indices returned are 0-based.
+ * @return False, after printing why, if the selection is malformed or selects nothing
+ */
+bool parseShapeSelection(const std::string& text, const Slide* slide, std::vector<size_t>& indices) {
+    if (!slide) {
+        std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                  << "No current slide." << std::endl;
+        return false;
+    }
+
+    size_t count = slide->getShapeCount();
+    indices.clear();
+    for (const std::string& part : Tokenizer::split(text, ',')) {
+        std::string item = Tokenizer::toLower(Tokenizer::trim(part));
+        if (item == "all") {
+            for (size_t i = 0; i < count; ++i) indices.push_back(i);
+            continue;
+        }
+
+        if (!item.empty() && std::isalpha(static_cast<unsigned char>(item[0]))) {
+            size_t before = indices.size();
+            for (size_t i = 0; i < count; ++i) {
+                if (Tokenizer::toLower(slide->getShape(i)->getName()) == item) {
+                    indices.push_back(i);
+                }
+            }
+            if (indices.size() == before) {
+                std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                          << "No shapes of type '" << Tokenizer::trim(part) << "' on this slide." << std::endl;
+                return false;
+            }
+            continue;
+        }
+
+        size_t first = 0;
+        size_t last = 0;
+        try {
+            size_t dash = item.find('-', 1);
+            first = std::stoul(item.substr(0, dash));
+            last = dash == std::string::npos ? first : std::stoul(item.substr(dash + 1));
+        } catch (...) {
+            std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                      << "Invalid index format." << std::endl;
+            return false;
+        }
+        if (first < 1 || last < first || last > count) {
+            std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                      << "Invalid shape index." << std::endl;
+            return false;
+        }
+        for (size_t i = first; i <= last; ++i) indices.push_back(i - 1);
+    }
+
+    if (indices.empty()) {
+        std::cout << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
+                  << "No shapes selected." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ============== Trace Output ==============
+void writeTrace(const std::string& tracePath) {
+    if (tracePath.empty()) {
+        return;
+    }
+    Tracer::stop();
+    if (Tracer::writeToFile(tracePath)) {
+        std::cerr << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
+                  << Tracer::getEventCount() << " trace events written to: " << tracePath << std::endl;
+    } else {
+        std::cerr << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                  << "Failed to write trace: " << tracePath << std::endl;
+    }
 }
 
 // ============== Main Entry Point ==============
@@ -455,24 +602,114 @@ int main(int argc, char* argv[]) {
     system("chcp 65001 > nul");  // UTF-8
     #endif
     
-    displayBanner();
+    // Separate option flags from presentation files
+    std::vector<std::string> filenames;
+    std::string scriptPath;
+    std::string socketPath;
+    std::string profilePath;
+    std::string tracePath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--batch") {
+            if (i + 1 >= argc) {
+                std::cerr << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                          << "Usage: " << argv[0] << " --batch <script.txt|-> [presentation.txt] ..." << std::endl;
+                return 2;
+            }
+            batchMode = true;
+            scriptPath = argv[++i];
+        } else if (arg == "--server") {
+            if (i + 1 >= argc) {
+                std::cerr << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                          << "Usage: " << argv[0] << " --server <socket-path> [presentation.txt] ..." << std::endl;
+                return 2;
+            }
+            socketPath = argv[++i];
+        } else if (arg == "--profile") {
+            Profiler::setEnabled(true);
+        } else if (arg == "--profile-out") {
+            if (i + 1 >= argc) {
+                std::cerr << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                          << "Usage: " << argv[0] << " --profile-out <stats.csv> [presentation.txt] ..." << std::endl;
+                return 2;
+            }
+            Profiler::setEnabled(true);
+            profilePath = argv[++i];
+        } else if (arg == "--trace") {
+            if (i + 1 >= argc) {
+                std::cerr << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                          << "Usage: " << argv[0] << " --trace <trace.json> [presentation.txt] ..." << std::endl;
+                return 2;
+            }
+            tracePath = argv[++i];
+        } else {
+            filenames.push_back(arg);
+        }
+    }
+
+    if (!tracePath.empty()) {
+        Tracer::setThreadName("main");
+        Tracer::start();
+    }
+
+    // Server mode keeps the given presentations loaded and serves clients until shutdown
+    if (!socketPath.empty()) {
+        SlideServer server;
+        if (!server.start(socketPath)) {
+            return 2;
+        }
+        for (const std::string& filename : filenames) {
+            server.handleRequest("load " + filename);
+        }
+        server.run();
+        writeTrace(tracePath);
+        return 0;
+    }
+
+    // Batch commands come from a script file, or from stdin when given "-"
+    std::ifstream scriptFile;
+    if (batchMode && scriptPath != "-") {
+        scriptFile.open(scriptPath);
+        if (!scriptFile.is_open()) {
+            std::cerr << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                      << "Failed to open script: " << scriptPath << std::endl;
+            return 2;
+        }
+        commandInput = &scriptFile;
+    }
+
+    // Buffer batch output instead of flushing on every std::endl
+    std::unique_ptr<BatchOutputBuffer> batchOutput;
+    std::streambuf* consoleBuffer = std::cout.rdbuf();
+    if (batchMode) {
+        std::ios::sync_with_stdio(false);
+        batchOutput = std::make_unique<BatchOutputBuffer>(stdout);
+        std::cout.rdbuf(batchOutput.get());
+    } else {
+        displayBanner();
     
-    if (argc < 2) {
-        std::cerr << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
-                  << "Usage: " << argv[0] << " <presentation1.txt> [presentation2.txt] ..." << std::endl;
-        std::cerr << Color::Gray().toAnsiFg() << "       Creating empty presentation..." << Color::resetAnsi() << std::endl;
+        if (filenames.empty()) {
+            std::cerr << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
+                      << "Usage: " << argv[0] << " <presentation1.txt> [presentation2.txt] ..." << std::endl;
+            std::cerr << Color::Yellow().toAnsiFg() << "       " << argv[0] << " --batch <script.txt|-> [presentation.txt] ..." << Color::resetAnsi() << std::endl;
+            std::cerr << Color::Gray().toAnsiFg() << "       Creating empty presentation..." << Color::resetAnsi() << std::endl;
+        }
     }
 
     // Load all presentations
     std::vector<std::unique_ptr<SlideShow>> slideshows;
     std::map<std::string, int> filenameToIndex;
 
-    std::cout << Color::Cyan().toAnsiFg() << "\n[INFO] " << Color::resetAnsi() << "Loading presentations..." << std::endl;
+    if (!batchMode) {
+        std::cout << Color::Cyan().toAnsiFg() << "\n[INFO] " << Color::resetAnsi() << "Loading presentations..." << std::endl;
+    }
     
-    for (int i = 1; i < argc; ++i) {
-        std::string filename = argv[i];
-        auto slideshow = loadPresentation(filename);
+    for (const std::string& filename : filenames) {
+        // Exported JSON decks load back through the JSON reader
+        auto slideshow = SlideShow::isJSONFile(filename) ? SlideShow::loadJSON(filename) : SlideShow::load(filename);
         if (slideshow && !slideshow->isEmpty()) {
+            // Bring back edits a crashed session journaled but never saved
+            slideshow->enableJournal();
             std::string normalizedName = CommandParser::normalizePath(filename);
             filenameToIndex[normalizedName] = static_cast<int>(slideshows.size());
             slideshows.push_back(std::move(slideshow));
@@ -484,8 +721,10 @@ int main(int argc, char* argv[]) {
         auto emptyShow = std::make_unique<SlideShow>("untitled.txt");
         emptyShow->addSlide(Slide());
         slideshows.push_back(std::move(emptyShow));
-        std::cout << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
-                  << "Created empty presentation." << std::endl;
+        if (!batchMode) {
+            std::cout << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
+                      << "Created empty presentation." << std::endl;
+        }
     }
 
     int currentShowIndex = 0;
@@ -493,31 +732,45 @@ int main(int argc, char* argv[]) {
     // Initialize undo manager for each slideshow
     std::vector<UndoManager> undoManagers(slideshows.size());
     
-    std::cout << Color::Green().toAnsiFg() << "\n[OK] " << Color::resetAnsi()
-              << slideshows.size() << " presentation(s) loaded. Type "
-              << Color::Yellow().toAnsiFg() << "help" << Color::resetAnsi() 
-              << " for commands.\n" << std::endl;
+    if (!batchMode) {
+        std::cout << Color::Green().toAnsiFg() << "\n[OK] " << Color::resetAnsi()
+                  << slideshows.size() << " presentation(s) loaded. Type "
+                  << Color::Yellow().toAnsiFg() << "help" << Color::resetAnsi() 
+                  << " for commands.\n" << std::endl;
+    }
 
     // Display initial slide
-    displayCurrentSlide(slideshows[currentShowIndex].get());
+    refreshCurrentSlide(slideshows[currentShowIndex].get());
 
     // Main CLI loop
     std::string input;
     bool running = true;
+    bool exitConfirmed = false;  // Unsaved edits may be dropped along with their journals
+    int lineNumber = 0;
+    int failedCommands = 0;
 
     while (running) {
-        displayPrompt(slideshows[currentShowIndex].get());
+        if (!batchMode) {
+            displayPrompt(slideshows[currentShowIndex].get());
+        }
         
-        if (!std::getline(std::cin, input)) {
+        if (!std::getline(*commandInput, input)) {
             break;
         }
+        ++lineNumber;
+
+        // Scripts may contain comment lines
+        if (batchMode && Tokenizer::trim(input).compare(0, 1, "#") == 0) {
+            continue;
+        }
 
         CommandParser::Command cmd = CommandParser::parse(input);
+        bool commandOk = true;
 
         switch (cmd.type) {
             case CommandParser::NEXT:
                 if (slideshows[currentShowIndex]->next()) {
-                    displayCurrentSlide(slideshows[currentShowIndex].get());
+                    refreshCurrentSlide(slideshows[currentShowIndex].get());
                 } else {
                     std::cout << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
                               << "Already at the last slide." << std::endl;
@@ -526,7 +779,7 @@ int main(int argc, char* argv[]) {
 
             case CommandParser::PREV:
                 if (slideshows[currentShowIndex]->prev()) {
-                    displayCurrentSlide(slideshows[currentShowIndex].get());
+                    refreshCurrentSlide(slideshows[currentShowIndex].get());
                 } else {
                     std::cout << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
                               << "Already at the first slide." << std::endl;
@@ -542,15 +795,17 @@ int main(int argc, char* argv[]) {
                 try {
                     int slideNum = std::stoi(cmd.args[0]);
                     if (slideshows[currentShowIndex]->gotoSlide(slideNum)) {
-                            displayCurrentSlide(slideshows[currentShowIndex].get());
+                            refreshCurrentSlide(slideshows[currentShowIndex].get());
                     } else {
                             std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
                                       << "Invalid slide number. Valid range: 1-" 
                                   << slideshows[currentShowIndex]->getTotalSlides() << std::endl;
+                            commandOk = false;
                         }
                     } catch (...) {
                         std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
                                   << "Invalid slide number format." << std::endl;
+                        commandOk = false;
                     }
                 }
                 break;
@@ -567,19 +822,22 @@ int main(int argc, char* argv[]) {
                             
                             if (slideshows[targetIndex]->gotoSlide(slideNum)) {
                                 currentShowIndex = targetIndex;
-                                displayCurrentSlide(slideshows[currentShowIndex].get());
+                                refreshCurrentSlide(slideshows[currentShowIndex].get());
                             } else {
                                 std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
                                           << "Invalid slide number for " << targetFile 
                                           << ". Valid range: 1-" << slideshows[targetIndex]->getTotalSlides() << std::endl;
+                                commandOk = false;
                             }
                         } catch (...) {
                             std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
                                       << "Invalid slide number format." << std::endl;
+                            commandOk = false;
                         }
                     } else {
                         std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
                                   << "Presentation not found: " << targetFile << std::endl;
+                        commandOk = false;
                         std::cout << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
                                   << "Available presentations:" << std::endl;
                         for (const auto& pair : filenameToIndex) {
@@ -595,7 +853,7 @@ int main(int argc, char* argv[]) {
                     std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
                               << "Switched to: " << Color::Yellow().toAnsiFg()
                               << slideshows[currentShowIndex]->getFilename() << Color::resetAnsi() << std::endl;
-                    displayCurrentSlide(slideshows[currentShowIndex].get());
+                    refreshCurrentSlide(slideshows[currentShowIndex].get());
                 } else {
                     std::cout << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
                               << "Already at the last presentation." << std::endl;
@@ -608,7 +866,7 @@ int main(int argc, char* argv[]) {
                     std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
                               << "Switched to: " << Color::Yellow().toAnsiFg()
                               << slideshows[currentShowIndex]->getFilename() << Color::resetAnsi() << std::endl;
-                    displayCurrentSlide(slideshows[currentShowIndex].get());
+                    refreshCurrentSlide(slideshows[currentShowIndex].get());
                 } else {
                     std::cout << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
                               << "Already at the first presentation." << std::endl;
@@ -625,43 +883,46 @@ int main(int argc, char* argv[]) {
                             *currentSlide,
                             "Add shape"
                         );
-                        interactiveAddShape(currentSlide);
-                        slideshows[currentShowIndex]->setModified(true);
+                        bool changed = false;
+                        commandOk = interactiveAddShape(currentSlide, changed);
+                        if (commandOk && changed) {
+                            slideshows[currentShowIndex]->markSlideModified(slideshows[currentShowIndex]->getCurrentSlideNumber());
+                        }
                     } else {
                         std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
                                   << "No current slide." << std::endl;
+                        commandOk = false;
                     }
                 }
                 break;
 
             case CommandParser::DELETE:
                 if (!cmd.args.empty()) {
-                    try {
-                        int index = std::stoi(cmd.args[0]) - 1;
-                        Slide* currentSlide = slideshows[currentShowIndex]->getCurrentSlide();
-                        if (currentSlide) {
-                            // Save state for undo before deleting
-                            undoManagers[currentShowIndex].saveState(
-                                slideshows[currentShowIndex]->getCurrentSlideNumber(),
-                                *currentSlide,
-                                "Delete shape"
-                            );
-                            if (currentSlide->removeShape(index)) {
-                                std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
-                                          << "Shape deleted." << std::endl;
-                                slideshows[currentShowIndex]->setModified(true);
-                            } else {
-                                std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
-                                          << "Invalid shape index." << std::endl;
-                            }
+                    Slide* currentSlide = slideshows[currentShowIndex]->getCurrentSlide();
+                    std::vector<size_t> indices;
+                    if (parseShapeSelection(cmd.args[0], currentSlide, indices)) {
+                        // Save state for undo before deleting
+                        undoManagers[currentShowIndex].saveState(
+                            slideshows[currentShowIndex]->getCurrentSlideNumber(),
+                            *currentSlide,
+                            indices.size() == 1 ? "Delete shape" : "Delete shapes"
+                        );
+                        size_t removed = currentSlide->removeShapes(indices);
+                        if (removed == 1) {
+                            std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
+                                      << "Shape deleted." << std::endl;
+                        } else {
+                            std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
+                                      << "Deleted " << removed << " shapes." << std::endl;
                         }
-                    } catch (...) {
-                        std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
-                                  << "Invalid index format." << std::endl;
+                        slideshows[currentShowIndex]->markSlideModified(slideshows[currentShowIndex]->getCurrentSlideNumber());
+                    } else {
+                        commandOk = false;
                     }
                 } else {
                     std::cout << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
-                              << "Usage: delete <shape_number>" << std::endl;
+                              << "Usage: delete <shapes>  (e.g. 3, 1,4-6, all, circle)" << std::endl;
+                    commandOk = false;
                 }
                 break;
 
@@ -677,16 +938,21 @@ int main(int argc, char* argv[]) {
                                 *currentSlide,
                                 "Edit shape"
                             );
-                            interactiveEditShape(currentSlide, index);
-                            slideshows[currentShowIndex]->setModified(true);
+                            bool changed = false;
+                            commandOk = interactiveEditShape(currentSlide, index, changed);
+                            if (commandOk && changed) {
+                                slideshows[currentShowIndex]->markSlideModified(slideshows[currentShowIndex]->getCurrentSlideNumber());
+                            }
                         }
                     } catch (...) {
                         std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
                                   << "Invalid index format." << std::endl;
+                        commandOk = false;
                     }
                 } else {
                     std::cout << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
                               << "Usage: edit <shape_number>" << std::endl;
+                    commandOk = false;
                 }
                 break;
 
@@ -709,13 +975,152 @@ int main(int argc, char* argv[]) {
                             *currentSlide,
                             "Clear all shapes"
                         );
-                        while (currentSlide->getShapeCount() > 0) {
-                            currentSlide->removeShape(0);
-                        }
+                        currentSlide->removeShapesIf([](const Shape&) { return true; });
                         std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
                                   << "All shapes cleared from current slide." << std::endl;
-                        slideshows[currentShowIndex]->setModified(true);
+                        slideshows[currentShowIndex]->markSlideModified(slideshows[currentShowIndex]->getCurrentSlideNumber());
+                    }
+                }
+                break;
+
+            case CommandParser::MOVE:
+                if (cmd.args.size() >= 3) {
+                    Slide* currentSlide = slideshows[currentShowIndex]->getCurrentSlide();
+                    std::vector<size_t> indices;
+                    int dx = 0;
+                    int dy = 0;
+                    try {
+                        dx = std::stoi(cmd.args[1]);
+                        dy = std::stoi(cmd.args[2]);
+                    } catch (...) {
+                        std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                                  << "Invalid offset." << std::endl;
+                        commandOk = false;
+                        break;
+                    }
+                    if (parseShapeSelection(cmd.args[0], currentSlide, indices)) {
+                        undoManagers[currentShowIndex].saveState(
+                            slideshows[currentShowIndex]->getCurrentSlideNumber(),
+                            *currentSlide,
+                            "Move shapes"
+                        );
+                        size_t moved = currentSlide->translateShapes(indices, dx, dy);
+                        std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
+                                  << "Moved " << moved << " shape(s)." << std::endl;
+                        slideshows[currentShowIndex]->markSlideModified(slideshows[currentShowIndex]->getCurrentSlideNumber());
+                    } else {
+                        commandOk = false;
+                    }
+                } else {
+                    std::cout << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
+                              << "Usage: move <shapes> <dx> <dy>" << std::endl;
+                    commandOk = false;
+                }
+                break;
+
+            case CommandParser::SCALE:
+                if (cmd.args.size() >= 2) {
+                    Slide* currentSlide = slideshows[currentShowIndex]->getCurrentSlide();
+                    std::vector<size_t> indices;
+                    double percent = 0.0;
+                    try {
+                        percent = std::stod(cmd.args[1]);
+                    } catch (...) {
+                        percent = 0.0;
+                    }
+                    if (!std::isfinite(percent) || !(percent > 0.0)) {
+                        std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                                  << "Scale must be a positive, finite percentage." << std::endl;
+                        commandOk = false;
+                    } else if (parseShapeSelection(cmd.args[0], currentSlide, indices)) {
+                        undoManagers[currentShowIndex].saveState(
+                            slideshows[currentShowIndex]->getCurrentSlideNumber(),
+                            *currentSlide,
+                            "Scale shapes"
+                        );
+                        size_t scaled = currentSlide->scaleShapes(indices, percent / 100.0);
+                        std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
+                                  << "Scaled " << scaled << " shape(s) to " << percent << "%." << std::endl;
+                        slideshows[currentShowIndex]->markSlideModified(slideshows[currentShowIndex]->getCurrentSlideNumber());
+                    } else {
+                        commandOk = false;
                     }
+                } else {
+                    std::cout << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
+                              << "Usage: scale <shapes> <percent>" << std::endl;
+                    commandOk = false;
+                }
+                break;
+
+            case CommandParser::RECOLOR:
+                if (cmd.args.size() >= 2) {
+                    Slide* currentSlide = slideshows[currentShowIndex]->getCurrentSlide();
+                    std::vector<size_t> indices;
+                    if (parseShapeSelection(cmd.args[0], currentSlide, indices)) {
+                        undoManagers[currentShowIndex].saveState(
+                            slideshows[currentShowIndex]->getCurrentSlideNumber(),
+                            *currentSlide,
+                            "Recolor shapes"
+                        );
+                        Color fill(cmd.args[1]);
+                        size_t recolored = cmd.args.size() >= 3
+                            ? currentSlide->recolorShapes(indices, fill, Color(cmd.args[2]))
+                            : currentSlide->recolorShapes(indices, fill);
+                        std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
+                                  << "Recolored " << recolored << " shape(s) to "
+                                  << fill.toAnsiFg() << fill.getName() << Color::resetAnsi() << "." << std::endl;
+                        slideshows[currentShowIndex]->markSlideModified(slideshows[currentShowIndex]->getCurrentSlideNumber());
+                    } else {
+                        commandOk = false;
+                    }
+                } else {
+                    std::cout << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
+                              << "Usage: recolor <shapes> <fill> [border]" << std::endl;
+                    commandOk = false;
+                }
+                break;
+
+            case CommandParser::DUPLICATE:
+                if (!cmd.args.empty()) {
+                    Slide* currentSlide = slideshows[currentShowIndex]->getCurrentSlide();
+                    std::vector<size_t> indices;
+                    int dx = 10;
+                    int dy = 10;
+                    if (cmd.args.size() >= 3) {
+                        try {
+                            dx = std::stoi(cmd.args[1]);
+                            dy = std::stoi(cmd.args[2]);
+                        } catch (...) {
+                            std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                                      << "Invalid offset." << std::endl;
+                            commandOk = false;
+                            break;
+                        }
+                    }
+                    if (parseShapeSelection(cmd.args[0], currentSlide, indices)) {
+                        undoManagers[currentShowIndex].saveState(
+                            slideshows[currentShowIndex]->getCurrentSlideNumber(),
+                            *currentSlide,
+                            "Duplicate shapes"
+                        );
+                        // Copy in slide order, then append the copies in one go
+                        std::vector<std::shared_ptr<Shape>> copies;
+                        currentSlide->transformShapes(indices, [&](Shape& shape) {
+                            std::shared_ptr<Shape> copy = shape.clone();
+                            copy->translate(dx, dy);
+                            copies.push_back(std::move(copy));
+                        });
+                        currentSlide->addShapes(copies);
+                        std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
+                                  << "Duplicated " << copies.size() << " shape(s)." << std::endl;
+                        slideshows[currentShowIndex]->markSlideModified(slideshows[currentShowIndex]->getCurrentSlideNumber());
+                    } else {
+                        commandOk = false;
+                    }
+                } else {
+                    std::cout << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
+                              << "Usage: duplicate <shapes> [dx dy]" << std::endl;
+                    commandOk = false;
                 }
                 break;
 
@@ -725,7 +1130,7 @@ int main(int argc, char* argv[]) {
                     slideshows[currentShowIndex]->gotoSlide(newIndex);
                     std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
                               << "Created new slide " << newIndex << "." << std::endl;
-                    displayCurrentSlide(slideshows[currentShowIndex].get());
+                    refreshCurrentSlide(slideshows[currentShowIndex].get());
                 }
                 break;
 
@@ -736,18 +1141,21 @@ int main(int argc, char* argv[]) {
                         if (slideshows[currentShowIndex]->removeSlide(slideNum)) {
                             std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
                                       << "Deleted slide " << slideNum << "." << std::endl;
-                            displayCurrentSlide(slideshows[currentShowIndex].get());
+                            refreshCurrentSlide(slideshows[currentShowIndex].get());
                         } else {
                             std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
                                       << "Invalid slide number." << std::endl;
+                            commandOk = false;
                         }
                     } catch (...) {
                         std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
                                   << "Invalid slide number format." << std::endl;
+                        commandOk = false;
                     }
                 } else {
                     std::cout << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
                               << "Usage: delslide <slide_number>" << std::endl;
+                    commandOk = false;
                 }
                 break;
 
@@ -755,55 +1163,80 @@ int main(int argc, char* argv[]) {
                 currentDisplayMode = MODE_VISUAL;
                 std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
                           << "Switched to visual mode." << std::endl;
-                displayCurrentSlide(slideshows[currentShowIndex].get());
+                refreshCurrentSlide(slideshows[currentShowIndex].get());
                 break;
 
             case CommandParser::TEXT:
                 currentDisplayMode = MODE_TEXT;
+                if (terminalRenderer.isActive()) {
+                    terminalRenderer.release();
+                    std::cout << Color::Gray().toAnsiFg() << "[INFO] Visual mode drew "
+                              << terminalRenderer.getFrameCount() << " frame(s), "
+                              << terminalRenderer.getTotalBytes() << " bytes total" 
+                              << Color::resetAnsi() << std::endl;
+                }
                 std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
                           << "Switched to text mode." << std::endl;
-                displayCurrentSlide(slideshows[currentShowIndex].get());
+                refreshCurrentSlide(slideshows[currentShowIndex].get());
                 break;
 
             case CommandParser::EXPORT:
                 if (!cmd.args.empty()) {
                     std::string filename = cmd.args[0];
                     bool success = false;
+                    bool antiAliased = !hasExportOption(cmd.args, "noaa");
+                    bool optimizedSvg = hasExportOption(cmd.args, "opt");
+                    SvgWriter svgWriter;
+                    svgWriter.setOptimized(optimizedSvg);
                     
                     // Determine format from extension
                     if (filename.size() > 4 && filename.substr(filename.size() - 4) == ".svg") {
-                        success = slideshows[currentShowIndex]->exportCurrentSlideSVG(filename);
+                        success = slideshows[currentShowIndex]->exportCurrentSlideSVG(filename, svgWriter);
                     } else {
                         // Default to BMP
                         if (filename.size() <= 4 || filename.substr(filename.size() - 4) != ".bmp") {
                             filename += ".bmp";
                         }
-                        success = slideshows[currentShowIndex]->exportCurrentSlideBMP(filename);
+                        success = slideshows[currentShowIndex]->exportCurrentSlideBMP(filename, antiAliased);
                     }
                     
                     if (success) {
                         std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
                                   << "Exported to: " << Color::Yellow().toAnsiFg() << filename 
                                   << Color::resetAnsi() << std::endl;
+                        const Slide* slide = slideshows[currentShowIndex]->getCurrentSlide();
+                        if (optimizedSvg && slide && filename.substr(filename.size() - 4) == ".svg") {
+                            uint64_t optimizedBytes = svgWriter.getBytesWritten();
+                            svgWriter.setOptimized(false);
+                            uint64_t plainBytes = slide->measureSVG(svgWriter);
+                            std::cout << Color::Cyan().toAnsiFg() << "[INFO] " << Color::resetAnsi()
+                                      << "Optimized SVG: "
+                                      << SvgWriter::describeReduction(plainBytes, optimizedBytes)
+                                      << std::endl;
+                        }
                     } else {
                         std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
                                   << "Failed to export." << std::endl;
+                        commandOk = false;
                     }
                 } else {
                     std::cout << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
-                              << "Usage: export <filename.bmp|filename.svg>" << std::endl;
+                              << "Usage: export <filename.bmp|filename.svg> [noaa] [opt]" << std::endl;
+                    commandOk = false;
                 }
                 break;
 
             case CommandParser::EXPORT_ALL:
                 {
                     std::string prefix = cmd.args.empty() ? "slide" : cmd.args[0];
+                    bool antiAliased = !hasExportOption(cmd.args, "noaa");
+                    bool optimizedSvg = hasExportOption(cmd.args, "opt");
                     std::cout << Color::Cyan().toAnsiFg() << "[INFO] " << Color::resetAnsi()
                               << "Exporting all slides as BMP..." << std::endl;
-                    slideshows[currentShowIndex]->exportAllSlidesBMP(prefix);
+                    slideshows[currentShowIndex]->exportAllSlidesBMP(prefix, antiAliased);
                     std::cout << Color::Cyan().toAnsiFg() << "[INFO] " << Color::resetAnsi()
                               << "Exporting all slides as SVG..." << std::endl;
-                    slideshows[currentShowIndex]->exportAllSlidesSVG(prefix);
+                    slideshows[currentShowIndex]->exportAllSlidesSVG(prefix, optimizedSvg);
                 }
                 break;
 
@@ -817,16 +1250,18 @@ int main(int argc, char* argv[]) {
                         filename += ".json";
                     }
                     
+                    bool pretty = !hasExportOption(cmd.args, "compact");
+                    
                     // Check if user wants to export entire slideshow (with "all" keyword)
-                    if (cmd.args.size() >= 2 && (cmd.args[1] == "all" || cmd.args[1] == "-a")) {
-                        success = slideshows[currentShowIndex]->exportSlideshowJSON(filename);
+                    if (hasExportOption(cmd.args, "all") || hasExportOption(cmd.args, "-a")) {
+                        success = slideshows[currentShowIndex]->exportSlideshowJSON(filename, pretty);
                         if (success) {
                             std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
                                       << "Exported entire slideshow to: " << Color::Yellow().toAnsiFg() 
                                       << filename << Color::resetAnsi() << std::endl;
                         }
                     } else {
-                        success = slideshows[currentShowIndex]->exportCurrentSlideJSON(filename);
+                        success = slideshows[currentShowIndex]->exportCurrentSlideJSON(filename, pretty);
                         if (success) {
                             std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
                                       << "Exported current slide to: " << Color::Yellow().toAnsiFg() 
@@ -837,12 +1272,14 @@ int main(int argc, char* argv[]) {
                     if (!success) {
                         std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
                                   << "Failed to export JSON." << std::endl;
+                        commandOk = false;
                     }
                 } else {
                     std::cout << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
-                              << "Usage: exportjson <filename.json> [all]" << std::endl;
-                    std::cout << Color::Gray().toAnsiFg() << "       Add 'all' to export entire slideshow" 
+                              << "Usage: exportjson <filename.json> [all] [compact]" << std::endl;
+                    std::cout << Color::Gray().toAnsiFg() << "       Add 'all' to export entire slideshow, 'compact' to drop indentation" 
                               << Color::resetAnsi() << std::endl;
+                    commandOk = false;
                 }
                 break;
                             
@@ -882,7 +1319,7 @@ int main(int argc, char* argv[]) {
                     std::cout << Color::Gray().toAnsiFg() << "[INFO] " << Color::resetAnsi()
                               << "Use 'add' to add shapes, then 'save' to save the file." << std::endl;
                     
-                    displayCurrentSlide(slideshows[currentShowIndex].get());
+                    refreshCurrentSlide(slideshows[currentShowIndex].get());
                 }
                 break;
 
@@ -896,6 +1333,7 @@ int main(int argc, char* argv[]) {
                     } else {
                         std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
                                   << "Failed to save file." << std::endl;
+                        commandOk = false;
                     }
                 }
                 break;
@@ -919,10 +1357,12 @@ int main(int argc, char* argv[]) {
                     } else {
                         std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
                                   << "Failed to save file." << std::endl;
+                        commandOk = false;
                     }
                 } else {
                     std::cout << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
                               << "Usage: saveas <filename.txt>" << std::endl;
+                    commandOk = false;
                 }
                 break;
 
@@ -938,11 +1378,12 @@ int main(int argc, char* argv[]) {
                             Slide* targetSlide = slideshows[currentShowIndex]->getCurrentSlide();
                             if (targetSlide) {
                                 *targetSlide = snapshot->slideState;
+                                slideshows[currentShowIndex]->markSlideModified(snapshot->slideIndex);
                             }
                             std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
                                       << "Undone: " << Color::Yellow().toAnsiFg() 
                                       << snapshot->description << Color::resetAnsi() << std::endl;
-                            displayCurrentSlide(slideshows[currentShowIndex].get());
+                            refreshCurrentSlide(slideshows[currentShowIndex].get());
                         }
                     } else {
                         std::cout << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
@@ -963,11 +1404,12 @@ int main(int argc, char* argv[]) {
                             Slide* targetSlide = slideshows[currentShowIndex]->getCurrentSlide();
                             if (targetSlide) {
                                 *targetSlide = snapshot->slideState;
+                                slideshows[currentShowIndex]->markSlideModified(snapshot->slideIndex);
                             }
                             std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
                                       << "Redone: " << Color::Yellow().toAnsiFg() 
                                       << snapshot->description << Color::resetAnsi() << std::endl;
-                            displayCurrentSlide(slideshows[currentShowIndex].get());
+                            refreshCurrentSlide(slideshows[currentShowIndex].get());
                         }
                     } else {
                         std::cout << Color::Yellow().toAnsiFg() << "[INFO] " << Color::resetAnsi()
@@ -1005,15 +1447,85 @@ int main(int argc, char* argv[]) {
                 }
                 break;
 
+            case CommandParser::STATS:
+                if (cmd.args.empty()) {
+                    std::cout << Color::Cyan().toAnsiFg() << "\n  ═══════════ Profiling Stats ═══════════"
+                              << Color::resetAnsi() << std::endl;
+                    if (!Profiler::isEnabled()) {
+                        std::cout << Color::Gray().toAnsiFg() << "  Profiling is off; start it with 'stats on' or --profile."
+                                  << Color::resetAnsi() << std::endl;
+                    }
+                    std::cout << Profiler::report() << std::endl;
+                } else {
+                    std::string action = Tokenizer::toLower(cmd.args[0]);
+                    if (action == "on" && cmd.args.size() == 1) {
+                        Profiler::setEnabled(true);
+                        std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
+                                  << "Profiling enabled." << std::endl;
+                    } else if (action == "off" && cmd.args.size() == 1) {
+                        Profiler::setEnabled(false);
+                        std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
+                                  << "Profiling disabled." << std::endl;
+                    } else if (action == "reset" && cmd.args.size() == 1) {
+                        Profiler::reset();
+                        std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
+                                  << "Profiling data cleared." << std::endl;
+                    } else if (action == "save" && cmd.args.size() == 2) {
+                        if (Profiler::dumpToFile(cmd.args[1])) {
+                            std::cout << Color::Green().toAnsiFg() << "[OK] " << Color::resetAnsi()
+                                      << "Profiling summary written to: " << Color::Yellow().toAnsiFg()
+                                      << cmd.args[1] << Color::resetAnsi() << std::endl;
+                        } else {
+                            std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                                      << "Failed to write: " << cmd.args[1] << std::endl;
+                            commandOk = false;
+                        }
+                    } else {
+                        std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                                  << "Usage: stats [on|off|reset|save <file>]" << std::endl;
+                        commandOk = false;
+                    }
+                }
+                break;
+
             case CommandParser::HELP:
                 displayHelp();
                 break;
 
             case CommandParser::EXIT:
-                std::cout << Color::Cyan().toAnsiFg() << "\n[INFO] " << Color::resetAnsi()
-                          << "Exiting slideshow. " << Color::Yellow().toAnsiFg() 
-                          << "Goodbye!" << Color::resetAnsi() << "\n" << std::endl;
-                running = false;
+                {
+                    // A script's exit line is its confirmation; interactive users are asked
+                    std::string unsaved;
+                    for (const auto& slideshow : slideshows) {
+                        if (slideshow->isModified()) {
+                            unsaved += unsaved.empty() ? "" : ", ";
+                            unsaved += slideshow->getFilename();
+                        }
+                    }
+                    if (!batchMode && !unsaved.empty()) {
+                        std::cout << Color::Yellow().toAnsiFg() << "[WARN] " << Color::resetAnsi()
+                                  << "Unsaved changes in: " << unsaved << std::endl;
+                        displayInputPrompt("  Discard them and exit? (y/n): ");
+                        std::string answer;
+                        if (!std::getline(*commandInput, answer)) {
+                            running = false;
+                            break;
+                        }
+                        answer = Tokenizer::toLower(Tokenizer::trim(answer));
+                        if (answer != "y" && answer != "yes") {
+                            std::cout << Color::Gray().toAnsiFg() << "[INFO] " << Color::resetAnsi()
+                                      << "Exit cancelled." << std::endl;
+                            break;
+                        }
+                    }
+                    if (!batchMode) {
+                        std::cout << Color::Cyan().toAnsiFg() << "\n[INFO] " << Color::resetAnsi()
+                                  << "Exiting slideshow. " << Color::Yellow().toAnsiFg() 
+                                  << "Goodbye!" << Color::resetAnsi() << "\n" << std::endl;
+                    }
+                    exitConfirmed = true;
+                    running = false;
+                }
                 break;
 
             case CommandParser::INVALID:
@@ -1021,12 +1533,58 @@ int main(int argc, char* argv[]) {
                     std::cout << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
                               << "Unknown command. Type " << Color::Yellow().toAnsiFg() 
                               << "help" << Color::resetAnsi() << " for available commands." << std::endl;
+                    commandOk = false;
                 }
                 break;
 
             default:
                 break;
         }
+
+        if (!commandOk) {
+            ++failedCommands;
+            if (batchMode) {
+                std::cerr << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                          << (scriptPath == "-" ? "<stdin>" : scriptPath) << ":" << lineNumber << ": " << Tokenizer::trim(input) << std::endl;
+            }
+        }
+
+        // Make this command's edits durable before waiting for the next one
+        for (const auto& slideshow : slideshows) {
+            if (!slideshow->syncJournal()) {
+                std::cerr << Color::Yellow().toAnsiFg() << "[WARN] " << Color::resetAnsi()
+                          << "Failed to write the edit journal of: " << slideshow->getFilename() << std::endl;
+            }
+        }
+    }
+
+    // Keep the journal of unsaved edits unless the user chose to drop them;
+    // input that ends without an exit (a closed pipe, a truncated script) keeps it
+    for (const auto& slideshow : slideshows) {
+        std::string journalPath = slideshow->getJournalPath();
+        if (exitConfirmed || !slideshow->isModified() || journalPath.empty()) {
+            slideshow->discardJournal();
+        } else {
+            std::cerr << Color::Yellow().toAnsiFg() << "[WARN] " << Color::resetAnsi()
+                      << "Unsaved edits to " << slideshow->getFilename() << " are kept in "
+                      << journalPath << " and will be recovered on the next start." << std::endl;
+        }
+    }
+
+    // Leave the terminal scrolling normally again
+    terminalRenderer.release();
+
+    writeTrace(tracePath);
+
+    if (!profilePath.empty() && !Profiler::dumpToFile(profilePath)) {
+        std::cerr << Color::Red().toAnsiFg() << "[ERR] " << Color::resetAnsi()
+                  << "Failed to write profiling summary: " << profilePath << std::endl;
+    }
+
+    if (batchMode) {
+        batchOutput->flushAll();
+        std::cout.rdbuf(consoleBuffer);
+        return failedCommands > 0 ? 1 : 0;
     }
 
     return 0;